@@ -0,0 +1,60 @@
+#include "Allocations.h"
+
+namespace
+{
+	std::atomic<std::uint64_t> s_allocations{ 0 };
+}
+
+// the array and nothrow forms forward to these
+void* operator new(std::size_t a_size)
+{
+	s_allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (const auto result = std::malloc(a_size ? a_size : 1))
+	{
+		return result;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t a_size, std::align_val_t a_alignment)
+{
+	s_allocations.fetch_add(1, std::memory_order_relaxed);
+
+	const auto alignment = static_cast<std::size_t>(a_alignment);
+	if (const auto result = std::aligned_alloc(alignment, (std::max<std::size_t>(a_size, 1) + alignment - 1) / alignment * alignment))
+	{
+		return result;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* a_ptr) noexcept
+{
+	std::free(a_ptr);
+}
+
+void operator delete(void* a_ptr, std::size_t) noexcept
+{
+	std::free(a_ptr);
+}
+
+void operator delete(void* a_ptr, std::align_val_t) noexcept
+{
+	std::free(a_ptr);
+}
+
+void operator delete(void* a_ptr, std::size_t, std::align_val_t) noexcept
+{
+	std::free(a_ptr);
+}
+
+namespace Allocations
+{
+	std::uint64_t GetCount() noexcept
+	{
+		return s_allocations.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// the host binary replaces the global allocation functions to count heap allocations, see Bench.h
+namespace Allocations
+{
+	// calls to operator new (every form) from all threads since startup
+	[[nodiscard]] std::uint64_t GetCount() noexcept;
+}
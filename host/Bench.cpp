@@ -0,0 +1,173 @@
+#include "Bench.h"
+
+#include <iostream>
+
+#include <SimpleIni.h>
+
+#include "Allocations.h"
+#include "Hooks.h"
+#include "RandomConditions.h"
+
+namespace Bench
+{
+	namespace
+	{
+		using namespace Conditions;
+
+		using clock_type = std::chrono::steady_clock;
+
+		// fixed so that every run times the same randomized arguments
+		constexpr std::uint32_t SEED = 1;
+
+		// allocations may grow by this much per call before a result regresses, absorbs amortized container growth
+		constexpr double ALLOCATION_TOLERANCE = 0.01;
+
+		struct Result
+		{
+			std::string name;
+			double      nsPerOp;
+			double      allocationsPerOp;
+		};
+
+		// median of several timed batches, the first batch also warms up caches
+		// allocations are averaged over every batch
+		template <class Tf>
+		Result TimeBatches(std::string a_name, std::uint32_t a_iterations, Tf a_func)
+		{
+			constexpr std::size_t BATCHES = 5;
+
+			std::array<double, BATCHES> results{};
+
+			const auto allocations = Allocations::GetCount();
+
+			for (auto& result : results)
+			{
+				const auto start = clock_type::now();
+
+				for (std::uint32_t i = 0; i < a_iterations; i++)
+				{
+					a_func();
+				}
+
+				result = std::chrono::duration<double, std::nano>(clock_type::now() - start).count() / a_iterations;
+			}
+
+			std::ranges::sort(results);
+
+			return {
+				std::move(a_name),
+				results[BATCHES / 2],
+				static_cast<double>(Allocations::GetCount() - allocations) / (static_cast<double>(a_iterations) * BATCHES)
+			};
+		}
+	}
+
+	int Run(const Population& a_population, const Options& a_options)
+	{
+		const auto player     = a_population.GetActors().front();
+		const auto iterations = std::max<std::uint32_t>(a_options.iterations, 1);
+
+		std::mt19937        rng(SEED);
+		std::vector<Result> results;
+
+		for (std::uint32_t i = 0; i < stl::to_underlying(ConditionID::kTotal); i++)
+		{
+			const auto id        = static_cast<ConditionID>(i);
+			const auto condition = RandomConditions::Create(id, a_population, rng, { .globalPercent = 0 });
+			if (!condition)
+			{
+				continue;
+			}
+
+			const auto name = GetConditionName(id);
+
+			results.emplace_back(TimeBatches(std::format("{}.Evaluate", name), iterations, [&] {
+				static_cast<void>(condition->Evaluate(player, nullptr));
+			}));
+
+			results.emplace_back(TimeBatches(std::format("{}.EvaluateUncached", name), iterations, [&] {
+				Hooks::AdvanceFrameEpoch();
+				static_cast<void>(condition->Evaluate(player, nullptr));
+			}));
+
+			results.emplace_back(TimeBatches(std::format("{}.GetArgument", name), iterations, [&] {
+				static_cast<void>(condition->GetArgument());
+			}));
+
+			results.emplace_back(TimeBatches(std::format("{}.GetCurrent", name), iterations, [&] {
+				static_cast<void>(condition->GetCurrent(player));
+			}));
+		}
+
+		const auto path = a_options.baseline.string();
+
+		CSimpleIniA baseline;
+		baseline.SetUnicode();
+
+		if (!a_options.save && baseline.LoadFile(path.c_str()) < 0)
+		{
+			logs::error("Failed to read the baseline {}, record one with 'bench --save'"sv, path);
+			return 2;
+		}
+
+		std::uint32_t regressions = 0;
+
+		std::cout << std::format("bench: {} iterations x 5 batches, median ns/op, allocations/op\n", iterations);
+
+		for (const auto& result : results)
+		{
+			if (a_options.save)
+			{
+				baseline.SetDoubleValue("Baseline", result.name.c_str(), result.nsPerOp, nullptr, true);
+				baseline.SetDoubleValue("Allocations", result.name.c_str(), result.allocationsPerOp, nullptr, true);
+
+				std::cout << std::format("  {:<55} {:>9.1f} ns {:>6.2f} allocs\n", result.name, result.nsPerOp, result.allocationsPerOp);
+				continue;
+			}
+
+			const auto previous            = baseline.GetDoubleValue("Baseline", result.name.c_str(), 0.0);
+			const auto previousAllocations = baseline.GetDoubleValue("Allocations", result.name.c_str(), 0.0);
+
+			if (previous <= 0.0)
+			{
+				std::cout << std::format("  {:<55} {:>9.1f} ns {:>6.2f} allocs (not in the baseline)\n", result.name, result.nsPerOp, result.allocationsPerOp);
+				continue;
+			}
+
+			const auto change    = (result.nsPerOp - previous) * 100.0 / previous;
+			const auto regressed = change > a_options.threshold || result.allocationsPerOp > previousAllocations + ALLOCATION_TOLERANCE;
+
+			regressions += regressed;
+
+			std::cout << std::format(
+				"  {:<55} {:>9.1f} ns ({:+6.1f}%) {:>6.2f} allocs (baseline {:.2f}){}\n",
+				result.name,
+				result.nsPerOp,
+				change,
+				result.allocationsPerOp,
+				previousAllocations,
+				regressed ? " REGRESSED" : "");
+		}
+
+		if (a_options.save)
+		{
+			if (baseline.SaveFile(path.c_str()) < 0)
+			{
+				logs::error("Failed to write the baseline {}"sv, path);
+				return 2;
+			}
+
+			std::cout << std::format("bench: baseline written to {}\n", path);
+			return 0;
+		}
+
+		if (regressions)
+		{
+			std::cout << std::format("bench: FAILED, {} results regressed by more than {:.1f}% or allocate more\n", regressions, a_options.threshold);
+			return 1;
+		}
+
+		std::cout << std::format("bench: PASSED, no result regressed by more than {:.1f}%\n", a_options.threshold);
+		return 0;
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Population.h"
+
+// microbenchmarks of the condition classes against the mocks, compared with a baseline file (host/baseline.ini)
+// every result is the median time of several batches and the heap allocations per call, counted by replacing the
+// global allocation functions of the host binary
+namespace Bench
+{
+	struct Options
+	{
+		std::filesystem::path baseline;              // read, or written when save is set
+		std::uint32_t         iterations{ 100000 };  // calls per timed batch
+		double                threshold{ 10.0 };     // percent a result may be slower than its baseline
+		bool                  save{ false };         // replace the baseline instead of comparing with it
+	};
+
+	// 0 if no result regressed (or the baseline was written), 1 on a regression, 2 if the baseline can't be read or written
+	[[nodiscard]] int Run(const Population& a_population, const Options& a_options);
+}
@@ -0,0 +1,551 @@
+#include "MockOAR.h"
+
+namespace MockOAR
+{
+	namespace
+	{
+		using namespace Conditions;
+
+		using allocator_type = rapidjson::Document::AllocatorType;
+
+		// like OAR's components, the value is read from and written to a member named after the component in the condition object
+		template <class T>
+		class Component :
+			public T
+		{
+		public:
+			using T::T;
+
+			void InitializeComponent(void* a_value) override
+			{
+				const auto& value = *static_cast<const rapidjson::Value*>(a_value);
+				if (!value.IsObject())
+				{
+					return;
+				}
+
+				const auto name = this->GetName();
+				if (const auto it = value.FindMember(name.c_str()); it != value.MemberEnd() && it->value.IsObject())
+				{
+					Read(it->value);
+				}
+			}
+
+			void SerializeComponent(void* a_value, void* a_allocator) override
+			{
+				auto& value     = *static_cast<rapidjson::Value*>(a_value);
+				auto& allocator = *static_cast<allocator_type*>(a_allocator);
+
+				rapidjson::Value object(rapidjson::kObjectType);
+				Write(object, allocator);
+
+				const auto name = this->GetName();
+				value.AddMember(rapidjson::Value(name.c_str(), allocator), object, allocator);
+			}
+
+		protected:
+			virtual void Read(const rapidjson::Value& a_value)                                = 0;
+			virtual void Write(rapidjson::Value& a_value, allocator_type& a_allocator) const = 0;
+		};
+
+		// actor values and graph variables have no source outside the game and read as 0
+		class NumericComponent :
+			public Component<INumericConditionComponent>
+		{
+			enum class Source
+			{
+				kStatic,
+				kGlobal,
+				kActorValue,
+				kGraphVariable
+			};
+
+		public:
+			using Component::Component;
+
+			void Read(const rapidjson::Value& a_value) override
+			{
+				if (const auto it = a_value.FindMember("value"); it != a_value.MemberEnd() && it->value.IsNumber())
+				{
+					SetStaticValue(it->value.GetFloat());
+				}
+				else if (const auto global = a_value.FindMember("globalVariable"); global != a_value.MemberEnd() && global->value.IsUint())
+				{
+					SetGlobalVariable(RE::TESForm::LookupByID<RE::TESGlobal>(global->value.GetUint()));
+				}
+				else if (const auto actorValue = a_value.FindMember("actorValue"); actorValue != a_value.MemberEnd() && actorValue->value.IsInt())
+				{
+					SetActorValue(static_cast<RE::ActorValue>(actorValue->value.GetInt()), ActorValueType::kActorValue);
+				}
+				else if (const auto graphVariable = a_value.FindMember("graphVariable"); graphVariable != a_value.MemberEnd() && graphVariable->value.IsString())
+				{
+					SetGraphVariable(graphVariable->value.GetString(), GraphVariableType::kFloat);
+				}
+			}
+
+			void Write(rapidjson::Value& a_value, allocator_type& a_allocator) const override
+			{
+				switch (source)
+				{
+				case Source::kStatic:
+					a_value.AddMember("value", staticValue, a_allocator);
+					break;
+				case Source::kGlobal:
+					a_value.AddMember("globalVariable", global ? global->GetFormID() : 0, a_allocator);
+					break;
+				case Source::kActorValue:
+					a_value.AddMember("actorValue", static_cast<std::int32_t>(actorValue), a_allocator);
+					break;
+				case Source::kGraphVariable:
+					a_value.AddMember("graphVariable", rapidjson::Value(graphVariable.c_str(), a_allocator), a_allocator);
+					break;
+				}
+			}
+
+			bool DisplayInUI(bool, float) override { return false; }
+
+			RE::BSString GetArgument() const override
+			{
+				switch (source)
+				{
+				case Source::kStatic:
+					return std::format("{}", staticValue).c_str();
+				case Source::kGlobal:
+					return std::format("Global(0x{:X})", global ? global->GetFormID() : 0).c_str();
+				case Source::kActorValue:
+					return std::format("ActorValue({})", static_cast<std::int32_t>(actorValue)).c_str();
+				default:
+					return graphVariable.c_str();
+				}
+			}
+
+			bool IsValid() const override { return source != Source::kGlobal || global; }
+
+			float GetNumericValue([[maybe_unused]] RE::TESObjectREFR* a_refr) const override
+			{
+				switch (source)
+				{
+				case Source::kStatic:
+					return staticValue;
+				case Source::kGlobal:
+					return global ? global->value : 0.0f;
+				default:
+					return 0.0f;
+				}
+			}
+
+			void SetStaticValue(float a_value) override
+			{
+				source      = Source::kStatic;
+				staticValue = a_value;
+			}
+
+			void SetGlobalVariable(RE::TESGlobal* a_global) override
+			{
+				source = Source::kGlobal;
+				global = a_global;
+			}
+
+			void SetActorValue(RE::ActorValue a_actorValue, [[maybe_unused]] ActorValueType a_valueType) override
+			{
+				source     = Source::kActorValue;
+				actorValue = a_actorValue;
+			}
+
+			void SetGraphVariable(const char* a_graphVariableName, [[maybe_unused]] GraphVariableType a_valueType) override
+			{
+				source        = Source::kGraphVariable;
+				graphVariable = a_graphVariableName;
+			}
+
+		private:
+			Source         source{ Source::kStatic };
+			float          staticValue{ 0.0f };
+			RE::TESGlobal* global{ nullptr };
+			RE::ActorValue actorValue{ RE::ActorValue::kNone };
+			std::string    graphVariable;
+		};
+
+		class BoolComponent :
+			public Component<IBoolConditionComponent>
+		{
+		public:
+			using Component::Component;
+
+			void Read(const rapidjson::Value& a_value) override
+			{
+				if (const auto it = a_value.FindMember("value"); it != a_value.MemberEnd() && it->value.IsBool())
+				{
+					boolValue = it->value.GetBool();
+				}
+			}
+
+			void Write(rapidjson::Value& a_value, allocator_type& a_allocator) const override
+			{
+				a_value.AddMember("value", boolValue, a_allocator);
+			}
+
+			bool         DisplayInUI(bool, float) override { return false; }
+			RE::BSString GetArgument() const override { return boolValue ? "true" : "false"; }
+			bool         IsValid() const override { return true; }
+
+			bool GetBoolValue() const override { return boolValue; }
+			void SetBoolValue(bool a_value) override { boolValue = a_value; }
+
+		private:
+			bool boolValue{ false };
+		};
+
+		class TextComponent :
+			public Component<ITextConditionComponent>
+		{
+		public:
+			using Component::Component;
+
+			void Read(const rapidjson::Value& a_value) override
+			{
+				if (const auto it = a_value.FindMember("value"); it != a_value.MemberEnd() && it->value.IsString())
+				{
+					text = it->value.GetString();
+				}
+			}
+
+			void Write(rapidjson::Value& a_value, allocator_type& a_allocator) const override
+			{
+				a_value.AddMember("value", rapidjson::Value(text.c_str(), a_allocator), a_allocator);
+			}
+
+			bool         DisplayInUI(bool, float) override { return false; }
+			RE::BSString GetArgument() const override { return text.c_str(); }
+			bool         IsValid() const override { return true; }
+
+			RE::BSString GetTextValue() const override { return text.c_str(); }
+			void         SetTextValue(const char* a_text) override { text = a_text; }
+			void         SetAllowSpaces([[maybe_unused]] bool a_bAllowSpaces) override {}
+
+		private:
+			std::string text;
+		};
+
+		class ComparisonComponent :
+			public Component<IComparisonConditionComponent>
+		{
+		public:
+			using Component::Component;
+
+			void Read(const rapidjson::Value& a_value) override
+			{
+				if (const auto it = a_value.FindMember("value"); it != a_value.MemberEnd() && it->value.IsUint())
+				{
+					SetComparisonOperator(static_cast<ComparisonOperator>(it->value.GetUint()));
+				}
+			}
+
+			void Write(rapidjson::Value& a_value, allocator_type& a_allocator) const override
+			{
+				a_value.AddMember("value", static_cast<std::uint32_t>(comparison), a_allocator);
+			}
+
+			bool DisplayInUI(bool, float) override { return false; }
+			bool IsValid() const override { return comparison < ComparisonOperator::kInvalid; }
+
+			RE::BSString GetArgument() const override
+			{
+				switch (comparison)
+				{
+				case ComparisonOperator::kEqual:
+					return "==";
+				case ComparisonOperator::kNotEqual:
+					return "!=";
+				case ComparisonOperator::kGreater:
+					return ">";
+				case ComparisonOperator::kGreaterEqual:
+					return ">=";
+				case ComparisonOperator::kLess:
+					return "<";
+				case ComparisonOperator::kLessEqual:
+					return "<=";
+				default:
+					return "INVALID";
+				}
+			}
+
+			bool GetComparisonResult(float a_valueA, float a_valueB) const override
+			{
+				switch (comparison)
+				{
+				case ComparisonOperator::kEqual:
+					return a_valueA == a_valueB;
+				case ComparisonOperator::kNotEqual:
+					return a_valueA != a_valueB;
+				case ComparisonOperator::kGreater:
+					return a_valueA > a_valueB;
+				case ComparisonOperator::kGreaterEqual:
+					return a_valueA >= a_valueB;
+				case ComparisonOperator::kLess:
+					return a_valueA < a_valueB;
+				case ComparisonOperator::kLessEqual:
+					return a_valueA <= a_valueB;
+				default:
+					return false;
+				}
+			}
+
+			ComparisonOperator GetComparisonOperator() const override { return comparison; }
+			void               SetComparisonOperator(ComparisonOperator a_operator) override { comparison = a_operator; }
+
+			RE::BSString GetComparisonOperatorFullName() const override { return GetArgument(); }
+
+		private:
+			ComparisonOperator comparison{ ComparisonOperator::kEqual };
+		};
+
+		class FormComponent :
+			public Component<IFormConditionComponent>
+		{
+		public:
+			using Component::Component;
+
+			void Read(const rapidjson::Value& a_value) override
+			{
+				if (const auto it = a_value.FindMember("formID"); it != a_value.MemberEnd() && it->value.IsUint())
+				{
+					form = RE::TESForm::LookupByID(it->value.GetUint());
+				}
+			}
+
+			void Write(rapidjson::Value& a_value, allocator_type& a_allocator) const override
+			{
+				a_value.AddMember("formID", form ? form->GetFormID() : 0, a_allocator);
+			}
+
+			bool DisplayInUI(bool, float) override { return false; }
+			bool IsValid() const override { return form != nullptr; }
+
+			RE::BSString GetArgument() const override
+			{
+				return form ? std::format("0x{:X}", form->GetFormID()).c_str() : "None";
+			}
+
+			RE::TESForm* GetTESFormValue() const override { return form; }
+			void         SetTESFormValue(RE::TESForm* a_form) override { form = a_form; }
+
+		private:
+			RE::TESForm* form{ nullptr };
+		};
+
+		template <class T>
+		IConditionComponent* CreateComponent(const ICondition* a_parentCondition, const char* a_name, const char* a_description)
+		{
+			return new T(a_parentCondition, a_name, a_description);
+		}
+
+		// what OAR's own condition class does for a custom condition: owns the components and the negated/disabled flags and does the serialization
+		class WrappedCondition :
+			public ICondition
+		{
+		public:
+			bool Evaluate(RE::TESObjectREFR*, RE::hkbClipGenerator*) const override { return false; }
+
+			void Initialize(void* a_value) override
+			{
+				const auto& value = *static_cast<const rapidjson::Value*>(a_value);
+				if (!value.IsObject())
+				{
+					return;
+				}
+
+				if (const auto it = value.FindMember("negated"); it != value.MemberEnd() && it->value.IsBool())
+				{
+					negated = it->value.GetBool();
+				}
+
+				if (const auto it = value.FindMember("disabled"); it != value.MemberEnd() && it->value.IsBool())
+				{
+					disabled = it->value.GetBool();
+				}
+
+				for (const auto& component : components)
+				{
+					component->InitializeComponent(a_value);
+				}
+			}
+
+			void Serialize(void* a_value, void* a_allocator, ICondition* a_outerCustomCondition) override
+			{
+				auto& value     = *static_cast<rapidjson::Value*>(a_value);
+				auto& allocator = *static_cast<allocator_type*>(a_allocator);
+
+				value.SetObject();
+
+				const auto name = a_outerCustomCondition ? a_outerCustomCondition->GetName() : GetName();
+				value.AddMember("condition", rapidjson::Value(name.c_str(), allocator), allocator);
+
+				if (negated)
+				{
+					value.AddMember("negated", true, allocator);
+				}
+
+				if (disabled)
+				{
+					value.AddMember("disabled", true, allocator);
+				}
+
+				for (const auto& component : components)
+				{
+					component->SerializeComponent(a_value, a_allocator);
+				}
+			}
+
+			void PostInitialize() override
+			{
+				for (const auto& component : components)
+				{
+					component->PostInitialize();
+				}
+			}
+
+			RE::BSString GetArgument() const override { return ""; }
+			RE::BSString GetCurrent(RE::TESObjectREFR*) const override { return ""; }
+
+			RE::BSString GetName() const override { return "Wrapped"; }
+			RE::BSString GetDescription() const override { return ""; }
+			REL::Version GetRequiredVersion() const override { return { 1, 0, 0 }; }
+			RE::BSString GetRequiredPluginName() const override { return ""; }
+			RE::BSString GetRequiredPluginAuthor() const override { return ""; }
+
+			bool IsDisabled() const override { return disabled; }
+			void SetDisabled(bool a_bDisabled) override { disabled = a_bDisabled; }
+			bool IsNegated() const override { return negated; }
+			void SetNegated(bool a_bNegated) override { negated = a_bNegated; }
+
+			std::uint32_t        GetNumComponents() const override { return static_cast<std::uint32_t>(components.size()); }
+			IConditionComponent* GetComponent(std::uint32_t a_index) const override { return a_index < components.size() ? components[a_index].get() : nullptr; }
+
+			IConditionComponent* AddComponent(ConditionComponentFactory a_factory, const char* a_name, const char* a_description) override
+			{
+				if (!a_factory)
+				{
+					return nullptr;
+				}
+
+				return components.emplace_back(a_factory(this, a_name, a_description)).get();
+			}
+
+			bool        IsCustomCondition() const override { return false; }
+			ICondition* GetWrappedCondition() const override { return nullptr; }
+
+		protected:
+			bool EvaluateImpl(RE::TESObjectREFR*, RE::hkbClipGenerator*) const override { return false; }
+
+		private:
+			std::vector<std::unique_ptr<IConditionComponent>> components;
+			bool                                              negated{ false };
+			bool                                              disabled{ false };
+		};
+
+		ICondition* CreateWrappedCondition()
+		{
+			return new WrappedCondition();
+		}
+
+		class ConditionsInterface :
+			public OAR_API::Conditions::IConditionsInterface2
+		{
+		public:
+			OAR_API::Conditions::APIResult AddCustomCondition(
+				[[maybe_unused]] SKSE::PluginHandle a_myPluginHandle,
+				[[maybe_unused]] const char*        a_myPluginName,
+				[[maybe_unused]] REL::Version       a_myPluginVersion,
+				const char*                         a_conditionName,
+				ConditionFactory                    a_conditionFactory) noexcept override
+			{
+				if (!a_conditionName || !a_conditionFactory)
+				{
+					return OAR_API::Conditions::APIResult::Invalid;
+				}
+
+				const std::lock_guard lock(factoriesLock);
+
+				if (!factories.emplace(a_conditionName, a_conditionFactory).second)
+				{
+					return OAR_API::Conditions::APIResult::AlreadyRegistered;
+				}
+
+				return OAR_API::Conditions::APIResult::OK;
+			}
+
+			ConditionFactory GetWrappedConditionFactory() noexcept override
+			{
+				return CreateWrappedCondition;
+			}
+
+			ConditionComponentFactory GetConditionComponentFactory(ConditionComponentType a_componentType) noexcept override
+			{
+				switch (a_componentType)
+				{
+				case ConditionComponentType::kForm:
+					return CreateComponent<FormComponent>;
+				case ConditionComponentType::kNumeric:
+					return CreateComponent<NumericComponent>;
+				case ConditionComponentType::kText:
+					return CreateComponent<TextComponent>;
+				case ConditionComponentType::kBool:
+					return CreateComponent<BoolComponent>;
+				case ConditionComponentType::kComparison:
+					return CreateComponent<ComparisonComponent>;
+				default:
+					return nullptr;
+				}
+			}
+
+			[[nodiscard]] ConditionFactory GetFactory(std::string_view a_name)
+			{
+				const std::lock_guard lock(factoriesLock);
+
+				const auto it = factories.find(a_name);
+				return it != factories.end() ? it->second : nullptr;
+			}
+
+		private:
+			std::mutex                                           factoriesLock;
+			std::map<std::string, ConditionFactory, std::less<>> factories;
+		};
+
+		ConditionsInterface s_interface;
+	}
+
+	OAR_API::Conditions::IConditionsInterface* GetInterface() noexcept
+	{
+		return std::addressof(s_interface);
+	}
+
+	std::unique_ptr<Conditions::ICondition> CreateCondition(std::string_view a_name)
+	{
+		const auto factory = s_interface.GetFactory(a_name);
+		return factory ? std::unique_ptr<Conditions::ICondition>(factory()) : nullptr;
+	}
+
+	std::unique_ptr<Conditions::ICondition> LoadCondition(const rapidjson::Value& a_value)
+	{
+		if (!a_value.IsObject())
+		{
+			return nullptr;
+		}
+
+		const auto name = a_value.FindMember("condition");
+		if (name == a_value.MemberEnd() || !name->value.IsString())
+		{
+			return nullptr;
+		}
+
+		auto condition = CreateCondition(name->value.GetString());
+		if (condition)
+		{
+			condition->Initialize(const_cast<rapidjson::Value*>(std::addressof(a_value)));
+			condition->PostInitialize();
+		}
+
+		return condition;
+	}
+}
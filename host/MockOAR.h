@@ -0,0 +1,18 @@
+#pragma once
+
+#include <rapidjson/document.h>
+
+#include "API/OpenAnimationReplacerAPI-Conditions.h"
+
+// OAR's side of the conditions API: the registry of custom conditions, the wrapped condition that owns the components,
+// and the numeric (static value or global), bool, text, comparison and form components with OAR's JSON layout
+namespace MockOAR
+{
+	[[nodiscard]] OAR_API::Conditions::IConditionsInterface* GetInterface() noexcept;
+
+	// nullptr if no condition with that name was registered
+	[[nodiscard]] std::unique_ptr<Conditions::ICondition> CreateCondition(std::string_view a_name);
+
+	// creates the condition named by a_value["condition"] and loads it the way OAR loads a config: Initialize, then PostInitialize
+	[[nodiscard]] std::unique_ptr<Conditions::ICondition> LoadCondition(const rapidjson::Value& a_value);
+}
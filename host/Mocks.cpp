@@ -0,0 +1,165 @@
+#include "Mocks.h"
+
+#include "MockOAR.h"
+#include "StringHelpers.h"
+
+namespace Mocks
+{
+	namespace
+	{
+		Settings s_settings;
+
+		const Actor* GetActor(const RE::TESObjectREFR* a_refr) noexcept
+		{
+			return a_refr ? dynamic_cast<const Actor*>(a_refr) : nullptr;
+		}
+
+		void Wait() noexcept
+		{
+			const auto latency = s_settings.latency;
+			if (!latency)
+			{
+				return;
+			}
+
+			const auto end = std::chrono::steady_clock::now() + std::chrono::nanoseconds(latency);
+			while (std::chrono::steady_clock::now() < end)
+			{
+			}
+		}
+
+		PluginInterfaceIED s_ied;
+		PluginInterfaceSDS s_sds;
+
+		PluginInterfaceIED* GetIED() { return std::addressof(s_ied); }
+		PluginInterfaceSDS* GetSDS() { return std::addressof(s_sds); }
+
+		OAR_API::Conditions::IConditionsInterface* RequestConditionsAPI(
+			[[maybe_unused]] OAR_API::Conditions::InterfaceVersion a_interfaceVersion,
+			[[maybe_unused]] const char*                            a_pluginName,
+			[[maybe_unused]] REL::Version                           a_pluginVersion)
+		{
+			return MockOAR::GetInterface();
+		}
+
+		struct Module
+		{
+			std::string_view name;
+			std::string_view symbol;
+			void*            address;
+			bool (*available)();
+		};
+
+		const std::array s_modules{
+			Module{ PluginInterfaceIED::PLUGIN_DLL, "SKMP_GetPluginInterface", reinterpret_cast<void*>(&GetIED), [] { return s_settings.hasIED; } },
+			Module{ PluginInterfaceSDS::PLUGIN_DLL, "SKMP_GetPluginInterface", reinterpret_cast<void*>(&GetSDS), [] { return s_settings.hasSDS; } },
+			Module{ "OpenAnimationReplacer.dll", "RequestPluginAPI_Conditions", reinterpret_cast<void*>(&RequestConditionsAPI), [] { return true; } },
+		};
+
+		class HostModuleLoader :
+			public ModuleLoader
+		{
+		public:
+			module_handle GetModule(const char* a_name) const override
+			{
+				for (auto& module : s_modules)
+				{
+					if (StringHelpers::iequals(module.name, a_name) && module.available())
+					{
+						return const_cast<Module*>(std::addressof(module));
+					}
+				}
+
+				return nullptr;
+			}
+
+			void* GetSymbol(module_handle a_module, const char* a_name) const override
+			{
+				const auto module = static_cast<const Module*>(a_module);
+				return module && module->symbol == a_name ? module->address : nullptr;
+			}
+		};
+
+		HostModuleLoader s_loader;
+	}
+
+	Settings& GetSettings() noexcept
+	{
+		return s_settings;
+	}
+
+	void Install()
+	{
+		ModuleLoader::Set(std::addressof(s_loader));
+	}
+}
+
+std::uint32_t PluginInterfaceIED::GetPluginVersion() const { return 1; }
+const char*   PluginInterfaceIED::GetPluginName() const { return "ImmersiveEquipmentDisplays"; }
+std::uint32_t PluginInterfaceIED::GetInterfaceVersion() const { return Mocks::GetSettings().iedInterfaceVersion; }
+const char*   PluginInterfaceIED::GetInterfaceName() const { return "IED"; }
+std::uint64_t PluginInterfaceIED::GetUniqueID() const { return UNIQUE_ID; }
+
+auto PluginInterfaceIED::GetPlacementHintForGearNode(RE::TESObjectREFR* a_refr, GearNodeID a_id) const -> WeaponPlacementID
+{
+	Mocks::Wait();
+
+	const auto actor = Mocks::GetActor(a_refr);
+	const auto index = stl::to_underlying(a_id);
+
+	return actor && index < Mocks::GEAR_NODE_COUNT ? actor->placements[index] : WeaponPlacementID::None;
+}
+
+auto PluginInterfaceIED::GetPlacementHintForEquippedWeapon(RE::TESObjectREFR* a_refr, bool a_leftHand) const -> WeaponPlacementID
+{
+	Mocks::Wait();
+
+	const auto actor = Mocks::GetActor(a_refr);
+	return actor ? actor->equippedPlacements[a_leftHand ? 1 : 0] : WeaponPlacementID::None;
+}
+
+RE::BSString PluginInterfaceIED::GetGearNodeParentName(RE::TESObjectREFR* a_refr, GearNodeID a_id) const
+{
+	Mocks::Wait();
+
+	const auto actor = Mocks::GetActor(a_refr);
+	const auto index = stl::to_underlying(a_id);
+
+	return actor && index < Mocks::GEAR_NODE_COUNT ? actor->parentNames[index].c_str() : "";
+}
+
+std::int32_t PluginInterfaceIED::GetPluginOption(PluginOptionKey a_key) const
+{
+	Mocks::Wait();
+
+	const auto& options = Mocks::GetSettings().pluginOptions;
+	const auto  index   = stl::to_underlying(a_key);
+
+	return index < options.size() ? options[index] : 0;
+}
+
+std::uint32_t PluginInterfaceSDS::GetPluginVersion() const { return 1; }
+const char*   PluginInterfaceSDS::GetPluginName() const { return "SimpleDualSheath"; }
+std::uint32_t PluginInterfaceSDS::GetInterfaceVersion() const { return 1; }
+const char*   PluginInterfaceSDS::GetInterfaceName() const { return "SDS"; }
+std::uint64_t PluginInterfaceSDS::GetUniqueID() const { return UNIQUE_ID; }
+
+bool PluginInterfaceSDS::GetShieldOnBackEnabled(RE::Actor* a_actor) const
+{
+	Mocks::Wait();
+
+	const auto actor = Mocks::GetActor(a_actor);
+	return actor && actor->shieldOnBack;
+}
+
+// events are not simulated, the driver invalidates ActorCache instead
+void PluginInterfaceSDS::RegisterForPlayerShieldOnBackEvent([[maybe_unused]] ::Events::EventSink<SDSPlayerShieldOnBackSwitchEvent>* a_sink)
+{
+}
+
+bool PluginInterfaceSDS::IsWeaponNodeSharingDisabled() const
+{
+	Mocks::Wait();
+
+	return Mocks::GetSettings().weaponNodeSharingDisabled;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ActorCache.h"
+
+// stand-ins for IED, SDS and OAR, served through ModuleLoader so the plugin's own query and registration code runs unchanged
+// IED and SDS read everything they report from Mocks::Actor, which the driver fills in between frames
+namespace Mocks
+{
+	using GearNodeID        = PluginInterfaceIED::GearNodeID;
+	using WeaponPlacementID = PluginInterfaceIED::WeaponPlacementID;
+
+	constexpr std::uint32_t GEAR_NODE_COUNT = ActorCache::PlacementCache::GEAR_NODE_COUNT;
+
+	class Actor :
+		public RE::Actor
+	{
+	public:
+		using RE::Actor::Actor;
+
+		std::array<WeaponPlacementID, GEAR_NODE_COUNT> placements{};
+		std::array<WeaponPlacementID, 2>               equippedPlacements{};  // right, left
+		std::array<RE::BSFixedString, GEAR_NODE_COUNT> parentNames{};
+		bool                                           shieldOnBack{ false };
+	};
+
+	// set before Install, read by the mock plugins without synchronization afterwards
+	struct Settings
+	{
+		std::uint32_t latency{ 0 };  // ns every IED and SDS call busy-waits, like a call into the real plugin
+		std::uint32_t iedInterfaceVersion{ 1 };
+		bool          hasIED{ true };
+		bool          hasSDS{ true };
+
+		std::array<std::int32_t, 2> pluginOptions{};
+		bool                        weaponNodeSharingDisabled{ false };
+	};
+
+	[[nodiscard]] Settings& GetSettings() noexcept;
+
+	// makes ModuleLoader serve the mock IED, SDS and OAR modules
+	void Install();
+}
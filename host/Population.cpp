@@ -0,0 +1,138 @@
+#include "Population.h"
+
+#include "ActorCache.h"
+
+namespace
+{
+	constexpr RE::FormID PLAYER_FORM_ID = 0x14;
+	constexpr RE::FormID FIRST_ACTOR    = 0xFF000800;
+	constexpr RE::FormID FIRST_WEAPON   = 0xFE000000;
+	constexpr RE::FormID SHIELD         = 0xFE000100;
+}
+
+Population::Population(std::uint32_t a_actorCount, std::uint32_t a_seed) :
+	rng(a_seed)
+{
+	for (const auto formID : EQUIP_SLOTS)
+	{
+		matchForms.emplace_back(AddForm<RE::BGSEquipSlot>(formID));
+	}
+
+	const auto slot = [](RE::FormID a_formID) {
+		return RE::TESForm::LookupByID<RE::BGSEquipSlot>(a_formID);
+	};
+
+	// one weapon of every type, plus a bound sword and bow
+	for (std::uint32_t i = 1; i < stl::to_underlying(RE::WEAPON_TYPE::kTotal) + 2; i++)
+	{
+		const auto type   = static_cast<RE::WEAPON_TYPE>(i < stl::to_underlying(RE::WEAPON_TYPE::kTotal) ? i : (i == 10 ? 1 : 7));
+		const auto weapon = AddForm<RE::TESObjectWEAP>(FIRST_WEAPON + i);
+
+		weapon->weaponType = type;
+		weapon->bound      = i >= stl::to_underlying(RE::WEAPON_TYPE::kTotal);
+
+		switch (type)
+		{
+		case RE::WEAPON_TYPE::kTwoHandSword:
+		case RE::WEAPON_TYPE::kTwoHandAxe:
+		case RE::WEAPON_TYPE::kBow:
+		case RE::WEAPON_TYPE::kCrossbow:
+			weapon->equipSlot = slot(EQUIP_SLOTS[3]);
+			break;
+		default:
+			weapon->equipSlot = slot(EQUIP_SLOTS[2]);
+			break;
+		}
+
+		weapons.emplace_back(weapon);
+		matchForms.emplace_back(weapon);
+	}
+
+	shield         = AddForm<RE::TESObjectARMO>(SHIELD);
+	shield->shield = true;
+
+	const auto list = AddForm<RE::BGSListForm>(FORM_LIST);
+	list->forms     = { slot(EQUIP_SLOTS[0]), weapons[1], weapons[6], weapons.back() };
+	matchForms.emplace_back(list);
+
+	AddForm<RE::TESGlobal>(GLOBAL)->value = 1.0f;
+
+	for (std::uint32_t i = 0; i < a_actorCount; i++)
+	{
+		const auto actor = AddForm<Mocks::Actor>(i ? FIRST_ACTOR + i : PLAYER_FORM_ID);
+		Randomize(*actor);
+		actors.emplace_back(actor);
+	}
+}
+
+Population::~Population()
+{
+	for (const auto& form : forms)
+	{
+		RE::TESForm::RemoveForm(form.get());
+	}
+}
+
+template <class T>
+T* Population::AddForm(RE::FormID a_formID)
+{
+	auto form   = std::make_unique<T>(a_formID);
+	auto result = form.get();
+
+	RE::TESForm::AddForm(result);
+	forms.emplace_back(std::move(form));
+
+	return result;
+}
+
+void Population::Mutate(std::uint32_t a_count)
+{
+	if (actors.empty())
+	{
+		return;
+	}
+
+	for (std::uint32_t i = 0; i < a_count; i++)
+	{
+		const auto actor = actors[rng() % actors.size()];
+
+		Randomize(*actor);
+		ActorCache::Invalidate(actor->GetFormID());
+	}
+}
+
+void Population::Randomize(Mocks::Actor& a_actor)
+{
+	const auto chance = [&](std::uint32_t a_percent) {
+		return rng() % 100 < a_percent;
+	};
+
+	const auto placement = [&] {
+		return chance(40) ? Mocks::WeaponPlacementID::None : static_cast<Mocks::WeaponPlacementID>(1 + rng() % 9);
+	};
+
+	a_actor.loaded3D = !chance(5);
+
+	const auto right = chance(80) ? weapons[rng() % weapons.size()] : nullptr;
+	const auto left  = chance(40) ? weapons[rng() % weapons.size()] : nullptr;
+
+	a_actor.equippedObjects = { right, left };
+	a_actor.wornShield      = !left && chance(40) ? shield : nullptr;
+
+	for (auto& id : a_actor.placements)
+	{
+		id = placement();
+	}
+
+	for (auto& id : a_actor.equippedPlacements)
+	{
+		id = placement();
+	}
+
+	for (auto& name : a_actor.parentNames)
+	{
+		name = chance(30) ? RE::BSFixedString() : RE::BSFixedString(NODE_NAMES[rng() % NODE_NAMES.size()]);
+	}
+
+	a_actor.shieldOnBack = chance(50);
+}
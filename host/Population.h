@@ -0,0 +1,60 @@
+#pragma once
+
+#include <random>
+
+#include "Mocks.h"
+
+// synthetic actors, weapons and equip slots for the host driver, registered with the form lookup for as long as the object lives
+// every actor gets random equipment, placement hints, parent node names and SDS state, Mutate rerolls some of them
+// between frames the way equip events and IED updates do in game
+class Population
+{
+public:
+	// parent node names IED reports, also used as condition arguments
+	static constexpr std::array NODE_NAMES{
+		"WeaponBack",
+		"WeaponSword",
+		"WeaponSwordLeft",
+		"WeaponAxe",
+		"WeaponMace",
+		"WeaponDagger",
+		"SHIELD",
+		"QUIVER",
+		"WeaponBow",
+	};
+
+	// vanilla equip slots: right hand, left hand, either hand, both hands
+	static constexpr std::array EQUIP_SLOTS{ RE::FormID(0x13F42), RE::FormID(0x13F43), RE::FormID(0x13F44), RE::FormID(0x13F45) };
+
+	// holds every equip slot and weapon, read as 1.0 by numeric components bound to it
+	static constexpr RE::FormID FORM_LIST = 0xFE000800;
+	static constexpr RE::FormID GLOBAL    = 0xFE000801;
+
+	Population(std::uint32_t a_actorCount, std::uint32_t a_seed);
+	~Population();
+
+	Population(const Population&)            = delete;
+	Population& operator=(const Population&) = delete;
+
+	// the player (0x14) comes first
+	[[nodiscard]] const std::vector<Mocks::Actor*>& GetActors() const noexcept { return actors; }
+
+	// equip slots, weapons and the form list, candidates for form components
+	[[nodiscard]] const std::vector<RE::TESForm*>& GetMatchForms() const noexcept { return matchForms; }
+
+	// rerolls a_count random actors and invalidates their ActorCache entries like the equip event handler does
+	void Mutate(std::uint32_t a_count);
+
+private:
+	template <class T>
+	T* AddForm(RE::FormID a_formID);
+
+	void Randomize(Mocks::Actor& a_actor);
+
+	std::mt19937                              rng;
+	std::vector<std::unique_ptr<RE::TESForm>> forms;
+	std::vector<Mocks::Actor*>                actors;
+	std::vector<RE::TESObjectWEAP*>           weapons;
+	std::vector<RE::TESForm*>                 matchForms;
+	RE::TESObjectARMO*                        shield{ nullptr };
+};
@@ -0,0 +1,84 @@
+#include "StringHelpers.h"
+
+namespace RE
+{
+	namespace
+	{
+		struct IHash
+		{
+			std::size_t operator()(std::string_view a_text) const noexcept
+			{
+				return static_cast<std::size_t>(StringHelpers::ihash(a_text));
+			}
+		};
+
+		struct IEquals
+		{
+			bool operator()(std::string_view a_lhs, std::string_view a_rhs) const noexcept
+			{
+				return StringHelpers::iequals(a_lhs, a_rhs);
+			}
+		};
+
+		std::shared_mutex                    s_formLock;
+		std::unordered_map<FormID, TESForm*> s_forms;
+
+		// pooled strings are never freed, like the game's pool during a session
+		std::mutex                                                                    s_poolLock;
+		std::unordered_map<std::string_view, std::unique_ptr<char[]>, IHash, IEquals> s_pool;
+
+		const auto s_start = std::chrono::steady_clock::now();
+	}
+
+	const char* BSFixedString::Intern(std::string_view a_text)
+	{
+		if (a_text.empty())
+		{
+			return nullptr;
+		}
+
+		const std::lock_guard lock(s_poolLock);
+
+		if (const auto it = s_pool.find(a_text); it != s_pool.end())
+		{
+			return it->second.get();
+		}
+
+		auto copy = std::make_unique<char[]>(a_text.size() + 1);
+		std::memcpy(copy.get(), a_text.data(), a_text.size());
+
+		const auto result = copy.get();
+		s_pool.emplace(std::string_view(result, a_text.size()), std::move(copy));
+
+		return result;
+	}
+
+	TESForm* TESForm::LookupByID(FormID a_formID)
+	{
+		const std::shared_lock lock(s_formLock);
+
+		const auto it = s_forms.find(a_formID);
+		return it != s_forms.end() ? it->second : nullptr;
+	}
+
+	void TESForm::AddForm(TESForm* a_form)
+	{
+		const std::unique_lock lock(s_formLock);
+		s_forms.insert_or_assign(a_form->GetFormID(), a_form);
+	}
+
+	void TESForm::RemoveForm(TESForm* a_form)
+	{
+		const std::unique_lock lock(s_formLock);
+
+		if (const auto it = s_forms.find(a_form->GetFormID()); it != s_forms.end() && it->second == a_form)
+		{
+			s_forms.erase(it);
+		}
+	}
+
+	std::uint32_t GetDurationOfApplicationRunTime() noexcept
+	{
+		return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - s_start).count());
+	}
+}
@@ -0,0 +1,169 @@
+#include "RandomConditions.h"
+
+#include "MockOAR.h"
+#include "StringHelpers.h"
+
+namespace RandomConditions
+{
+	namespace
+	{
+		using namespace Conditions;
+
+		constexpr std::array PATTERNS{
+			"Weapon*",
+			"*Sword*",
+			"Weapon?ack",
+			"*left",
+			"*",
+		};
+
+		std::uint32_t Uniform(std::mt19937& a_rng, std::uint32_t a_min, std::uint32_t a_max)
+		{
+			return std::uniform_int_distribution<std::uint32_t>(a_min, a_max)(a_rng);
+		}
+
+		float RandomNumeric(std::string_view a_name, std::mt19937& a_rng)
+		{
+			if (a_name == "Gear node ID"sv)
+			{
+				return static_cast<float>(Uniform(a_rng, 1, 18));
+			}
+			if (a_name == "Gear node mask"sv)
+			{
+				return static_cast<float>((1u << Uniform(a_rng, 1, 18)) | (1u << Uniform(a_rng, 1, 18)) | (1u << Uniform(a_rng, 1, 18)));
+			}
+			if (a_name == "Weapon placement ID"sv)
+			{
+				return static_cast<float>(Uniform(a_rng, 0, 9));
+			}
+			if (a_name == "Required traits"sv)
+			{
+				return static_cast<float>(1u << Uniform(a_rng, 0, 17));
+			}
+			if (a_name == "Forbidden traits"sv)
+			{
+				return Uniform(a_rng, 0, 1) ? static_cast<float>(1u << Uniform(a_rng, 0, 17)) : 0.0f;
+			}
+			if (a_name == "Key"sv || a_name == "Match value"sv)
+			{
+				return static_cast<float>(Uniform(a_rng, 0, 1));
+			}
+
+			return 0.0f;
+		}
+
+		// exact names with random case, or a wildcard pattern
+		std::string RandomNodeName(std::mt19937& a_rng)
+		{
+			if (Uniform(a_rng, 0, 3) == 0)
+			{
+				return PATTERNS[Uniform(a_rng, 0, PATTERNS.size() - 1)];
+			}
+
+			std::string result = Population::NODE_NAMES[Uniform(a_rng, 0, Population::NODE_NAMES.size() - 1)];
+
+			if (Uniform(a_rng, 0, 1))
+			{
+				std::ranges::transform(result, result.begin(), StringHelpers::tolower);
+			}
+
+			return result;
+		}
+
+		std::string RandomNodeNameList(std::mt19937& a_rng)
+		{
+			std::string result;
+
+			for (auto count = Uniform(a_rng, 1, 4); count; count--)
+			{
+				if (!result.empty())
+				{
+					result += ", ";
+				}
+
+				result += Population::NODE_NAMES[Uniform(a_rng, 0, Population::NODE_NAMES.size() - 1)];
+			}
+
+			return result;
+		}
+	}
+
+	std::unique_ptr<ICondition> Create(
+		ConditionID       a_id,
+		const Population& a_population,
+		std::mt19937&     a_rng,
+		const Options&    a_options)
+	{
+		const auto name = GetConditionName(a_id);
+
+		auto condition = MockOAR::CreateCondition(name);
+		if (!condition)
+		{
+			return nullptr;
+		}
+
+		rapidjson::Document document(rapidjson::kObjectType);
+		auto&               allocator = document.GetAllocator();
+
+		document.AddMember("condition", rapidjson::Value(name.data(), static_cast<rapidjson::SizeType>(name.size()), allocator), allocator);
+
+		if (Uniform(a_rng, 0, 4) == 0)
+		{
+			document.AddMember("negated", true, allocator);
+		}
+
+		for (std::uint32_t i = 0; i < condition->GetNumComponents(); i++)
+		{
+			const auto component     = condition->GetComponent(i);
+			const auto componentName = component->GetName();
+			const auto text          = std::string_view(componentName.c_str());
+
+			rapidjson::Value value(rapidjson::kObjectType);
+
+			switch (component->GetType())
+			{
+			case ConditionComponentType::kNumeric:
+				if (text == "Cache (ms)"sv)
+				{
+					value.AddMember("value", static_cast<float>(a_options.cacheTime), allocator);
+				}
+				else if (Uniform(a_rng, 0, 99) < a_options.globalPercent)
+				{
+					value.AddMember("globalVariable", Population::GLOBAL, allocator);
+				}
+				else
+				{
+					value.AddMember("value", RandomNumeric(text, a_rng), allocator);
+				}
+				break;
+			case ConditionComponentType::kBool:
+				value.AddMember("value", text == "Cache per clip"sv ? a_options.clipCache : Uniform(a_rng, 0, 1) != 0, allocator);
+				break;
+			case ConditionComponentType::kComparison:
+				value.AddMember("value", Uniform(a_rng, 0, stl::to_underlying(ComparisonOperator::kInvalid) - 1), allocator);
+				break;
+			case ConditionComponentType::kText:
+				{
+					const auto nodeNames = text == "Node names"sv ? RandomNodeNameList(a_rng) : RandomNodeName(a_rng);
+					value.AddMember("value", rapidjson::Value(nodeNames.c_str(), allocator), allocator);
+				}
+				break;
+			case ConditionComponentType::kForm:
+				{
+					const auto& forms = a_population.GetMatchForms();
+					value.AddMember("formID", forms[Uniform(a_rng, 0, static_cast<std::uint32_t>(forms.size() - 1))]->GetFormID(), allocator);
+				}
+				break;
+			default:
+				continue;
+			}
+
+			document.AddMember(rapidjson::Value(componentName.c_str(), allocator), value, allocator);
+		}
+
+		condition->Initialize(std::addressof(document));
+		condition->PostInitialize();
+
+		return condition;
+	}
+}
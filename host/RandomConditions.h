@@ -0,0 +1,23 @@
+#pragma once
+
+#include "API/OpenAnimationReplacer-ConditionTypes.h"
+#include "ConditionID.h"
+#include "Population.h"
+
+// condition instances with random arguments, serialized to OAR's JSON layout and loaded through the mock OAR like a config
+namespace RandomConditions
+{
+	struct Options
+	{
+		std::uint32_t globalPercent{ 10 };  // chance that a numeric component reads Population::GLOBAL instead of a static value
+		std::uint32_t cacheTime{ 0 };       // ms written to every 'Cache (ms)' component
+		bool          clipCache{ false };   // written to every 'Cache per clip' component
+	};
+
+	// nullptr if the condition type was not registered
+	[[nodiscard]] std::unique_ptr<Conditions::ICondition> Create(
+		Conditions::ConditionID a_id,
+		const Population&       a_population,
+		std::mt19937&           a_rng,
+		const Options&          a_options = {});
+}
@@ -0,0 +1,433 @@
+#include "Replay.h"
+
+#include <fstream>
+#include <iostream>
+
+#include "ActorCache.h"
+#include "Capture.h"
+#include "Hooks.h"
+#include "MockOAR.h"
+#include "Mocks.h"
+#include "SettingsSnapshot.h"
+
+namespace Replay
+{
+	namespace
+	{
+		using namespace Conditions;
+
+		using WeaponPlacementID = PluginInterfaceIED::WeaponPlacementID;
+		using Strings           = std::unordered_map<std::uint32_t, std::string>;
+
+		class CaptureFile
+		{
+		public:
+			// false, with the reason logged, if the file is missing or was written by another version
+			bool Load(const std::filesystem::path& a_path)
+			{
+				std::ifstream file(a_path, std::ios::binary | std::ios::ate);
+				if (!file)
+				{
+					logs::error("Failed to open {}"sv, a_path.string());
+					return false;
+				}
+
+				const auto size = static_cast<std::size_t>(file.tellg());
+				if (size < sizeof(Capture::FileHeader))
+				{
+					logs::error("{} is not a capture"sv, a_path.string());
+					return false;
+				}
+
+				data.resize((size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+
+				file.seekg(0);
+				file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size));
+
+				const auto header = GetHeader();
+
+				if (std::memcmp(header->magic, "OARIEDCP", sizeof(header->magic)) != 0 ||
+				    header->version != Capture::FILE_VERSION ||
+				    header->recordSize != sizeof(Capture::Record) ||
+				    sizeof(Capture::FileHeader) + header->capacity * sizeof(Capture::Record) > size)
+				{
+					logs::error("{} is not a version {} capture"sv, a_path.string(), Capture::FILE_VERSION);
+					return false;
+				}
+
+				return true;
+			}
+
+			[[nodiscard]] const Capture::FileHeader* GetHeader() const noexcept
+			{
+				return reinterpret_cast<const Capture::FileHeader*>(data.data());
+			}
+
+			// the complete records still in the ring, oldest first
+			template <class Tf>
+			void ForEachRecord(Tf a_func) const
+			{
+				const auto header   = GetHeader();
+				const auto records  = reinterpret_cast<const Capture::Record*>(header + 1);
+				const auto head     = header->head.load(std::memory_order_relaxed);
+				const auto capacity = header->capacity;
+
+				for (auto n = std::max(head, capacity) - capacity; n < head; n++)
+				{
+					const auto& record = records[n % capacity];
+					if (record.sequence.load(std::memory_order_relaxed) == n + 1)
+					{
+						a_func(n, record);
+					}
+				}
+			}
+
+		private:
+			std::vector<std::uint64_t> data;
+		};
+
+		Strings LoadStrings(const std::filesystem::path& a_path)
+		{
+			Strings result;
+
+			std::ifstream file(Capture::GetStringsPath(a_path));
+
+			for (std::string line; std::getline(file, line);)
+			{
+				const auto tab = line.find('\t');
+				if (tab == std::string::npos)
+				{
+					continue;
+				}
+
+				result.try_emplace(static_cast<std::uint32_t>(std::stoul(line.substr(0, tab), nullptr, 16)), line.substr(tab + 1));
+			}
+
+			return result;
+		}
+
+		const std::string* FindString(const Strings& a_strings, std::int32_t a_hash)
+		{
+			const auto it = a_strings.find(static_cast<std::uint32_t>(a_hash));
+			return it != a_strings.end() ? std::addressof(it->second) : nullptr;
+		}
+
+		// a condition with every argument of the record as a static value, nullptr if a text is missing from the strings file
+		std::unique_ptr<ICondition> CreateCondition(const Capture::Record& a_record, const Strings& a_strings)
+		{
+			const auto name      = GetConditionName(static_cast<ConditionID>(a_record.conditionID));
+			const auto prototype = MockOAR::CreateCondition(name);
+			if (!prototype)
+			{
+				return nullptr;
+			}
+
+			rapidjson::Document document(rapidjson::kObjectType);
+			auto&               allocator = document.GetAllocator();
+
+			document.AddMember("condition", rapidjson::Value(name.data(), static_cast<rapidjson::SizeType>(name.size()), allocator), allocator);
+
+			if (a_record.negated)
+			{
+				document.AddMember("negated", true, allocator);
+			}
+
+			std::uint32_t argument = 0;
+
+			for (std::uint32_t i = 0; i < prototype->GetNumComponents(); i++)
+			{
+				const auto component     = prototype->GetComponent(i);
+				const auto componentName = component->GetName();
+				const auto text          = std::string_view(componentName.c_str());
+
+				if (text == "Cache (ms)"sv || text == "Cache per clip"sv)
+				{
+					continue;
+				}
+
+				if (argument >= a_record.argumentCount)
+				{
+					return nullptr;
+				}
+
+				const auto value = a_record.values[argument++];
+
+				rapidjson::Value member(rapidjson::kObjectType);
+
+				switch (component->GetType())
+				{
+				case ConditionComponentType::kNumeric:
+					member.AddMember("value", static_cast<float>(value), allocator);
+					break;
+				case ConditionComponentType::kBool:
+					member.AddMember("value", value != 0, allocator);
+					break;
+				case ConditionComponentType::kComparison:
+					member.AddMember("value", static_cast<std::uint32_t>(value), allocator);
+					break;
+				case ConditionComponentType::kText:
+					{
+						const auto string = FindString(a_strings, value);
+						if (!string)
+						{
+							return nullptr;
+						}
+
+						member.AddMember("value", rapidjson::Value(string->c_str(), allocator), allocator);
+					}
+					break;
+				case ConditionComponentType::kForm:
+					member.AddMember("formID", static_cast<RE::FormID>(value), allocator);
+					break;
+				default:
+					continue;
+				}
+
+				document.AddMember(rapidjson::Value(componentName.c_str(), allocator), member, allocator);
+			}
+
+			return MockOAR::LoadCondition(document);
+		}
+
+		enum class Skip
+		{
+			kNone,
+			kGameState,  // the condition reads equipment from the game
+			kIncomplete  // arguments or responses were truncated, or a text is missing from the strings file
+		};
+
+		// makes the mock plugins answer with the responses of the record
+		Skip ApplyResponses(const Capture::Record& a_record, const Strings& a_strings, Mocks::Actor& a_actor)
+		{
+			const auto arguments = std::span(a_record.values, a_record.argumentCount);
+			const auto responses = std::span(a_record.values + a_record.argumentCount, a_record.responseCount);
+
+			a_actor.placements.fill(WeaponPlacementID::None);
+			a_actor.equippedPlacements.fill(WeaponPlacementID::None);
+			a_actor.parentNames.fill({});
+			a_actor.shieldOnBack = false;
+
+			const auto gearNode = [&] {
+				return static_cast<std::uint32_t>(arguments[0]);
+			};
+
+			auto& settings = Mocks::GetSettings();
+
+			switch (static_cast<ConditionID>(a_record.conditionID))
+			{
+			case ConditionID::kIEDNodePlacement:
+				if (arguments.empty() || responses.size() != 1)
+				{
+					return Skip::kIncomplete;
+				}
+
+				if (gearNode() < Mocks::GEAR_NODE_COUNT)
+				{
+					a_actor.placements[gearNode()] = static_cast<WeaponPlacementID>(responses[0]);
+				}
+				break;
+			case ConditionID::kIEDNodesPlacement:
+				{
+					if (arguments.empty())
+					{
+						return Skip::kIncomplete;
+					}
+
+					const auto mask = static_cast<std::uint32_t>(arguments[0]) & ActorCache::PlacementCache::GEAR_NODE_MASK;
+					if (responses.size() != static_cast<std::size_t>(std::popcount(mask) + 7) / 8)
+					{
+						return Skip::kIncomplete;
+					}
+
+					std::uint32_t index = 0;
+
+					for (auto bits = mask; bits; bits &= bits - 1, index++)
+					{
+						const auto packed = static_cast<std::uint32_t>(responses[index / 8]);
+						a_actor.placements[std::countr_zero(bits)] = static_cast<WeaponPlacementID>((packed >> (index % 8 * 4)) & 0xF);
+					}
+				}
+				break;
+			case ConditionID::kIEDNodeEquippedPlacement:
+				if (arguments.empty() || responses.size() != 1)
+				{
+					return Skip::kIncomplete;
+				}
+
+				a_actor.equippedPlacements[arguments[0] ? 1 : 0] = static_cast<WeaponPlacementID>(responses[0]);
+
+				// the actor only counts as having placements when a gear node reports one, no condition reads gear node 0
+				a_actor.placements[0] = static_cast<WeaponPlacementID>(responses[0]);
+				break;
+			case ConditionID::kIEDNodeParentName:
+			case ConditionID::kIEDNodeParentNameInList:
+				{
+					if (arguments.empty() || responses.size() != 1)
+					{
+						return Skip::kIncomplete;
+					}
+
+					const auto name = FindString(a_strings, responses[0]);
+					if (!name)
+					{
+						return Skip::kIncomplete;
+					}
+
+					if (gearNode() < Mocks::GEAR_NODE_COUNT)
+					{
+						a_actor.parentNames[gearNode()] = RE::BSFixedString(name->c_str());
+					}
+				}
+				break;
+			case ConditionID::kIEDPluginOption:
+				if (arguments.empty() || responses.size() != 1)
+				{
+					return Skip::kIncomplete;
+				}
+
+				if (static_cast<std::uint32_t>(arguments[0]) < settings.pluginOptions.size())
+				{
+					settings.pluginOptions[static_cast<std::uint32_t>(arguments[0])] = responses[0];
+				}
+
+				SettingsSnapshot::Refresh();
+				break;
+			case ConditionID::kSDSShieldOnBackEnabled:
+				if (responses.size() != 1)
+				{
+					return Skip::kIncomplete;
+				}
+
+				a_actor.shieldOnBack = responses[0] != 0;
+				break;
+			case ConditionID::kSDSWeaponNodeSharingDisabled:
+				if (responses.size() != 1)
+				{
+					return Skip::kIncomplete;
+				}
+
+				settings.weaponNodeSharingDisabled = responses[0] != 0;
+
+				SettingsSnapshot::Refresh();
+				break;
+			default:
+				return Skip::kGameState;
+			}
+
+			// nothing fetched for an earlier record may be served for this one
+			ActorCache::Invalidate(a_actor.GetFormID());
+			Hooks::AdvanceFrameEpoch();
+
+			return Skip::kNone;
+		}
+	}
+
+	int Run(const std::filesystem::path& a_path, const Options& a_options)
+	{
+		CaptureFile capture;
+		if (!capture.Load(a_path))
+		{
+			return 2;
+		}
+
+		const auto strings = LoadStrings(a_path);
+
+		std::map<std::vector<std::int32_t>, std::unique_ptr<ICondition>> conditions;
+		std::unordered_map<RE::FormID, std::unique_ptr<Mocks::Actor>>   actors;
+
+		std::uint64_t records     = 0;
+		std::uint64_t evaluations = 0;
+		std::uint64_t mismatches  = 0;
+		std::uint64_t cached      = 0;
+		std::uint64_t skipped     = 0;
+
+		std::chrono::nanoseconds elapsed{ 0 };
+
+		for (std::uint32_t pass = 0; pass < std::max(a_options.passes, 1u); pass++)
+		{
+			capture.ForEachRecord([&](std::uint64_t a_number, const Capture::Record& a_record) {
+				const auto firstPass = pass == 0;
+
+				records += firstPass;
+
+				if (a_record.source != Capture::Source::kEvaluated)
+				{
+					cached += firstPass;
+					return;
+				}
+
+				if (!a_record.formID || a_record.conditionID >= stl::to_underlying(ConditionID::kTotal))
+				{
+					skipped += firstPass;
+					return;
+				}
+
+				auto& actor = actors[a_record.formID];
+				if (!actor)
+				{
+					actor = std::make_unique<Mocks::Actor>(a_record.formID);
+					RE::TESForm::AddForm(actor.get());
+				}
+
+				if (ApplyResponses(a_record, strings, *actor) != Skip::kNone)
+				{
+					skipped += firstPass;
+					return;
+				}
+
+				std::vector<std::int32_t> key{ a_record.conditionID, a_record.negated };
+				key.insert(key.end(), a_record.values, a_record.values + a_record.argumentCount);
+
+				auto& condition = conditions[std::move(key)];
+				if (!condition)
+				{
+					condition = CreateCondition(a_record, strings);
+				}
+
+				if (!condition)
+				{
+					skipped += firstPass;
+					return;
+				}
+
+				const auto start  = std::chrono::steady_clock::now();
+				const auto result = condition->Evaluate(actor.get(), nullptr);
+
+				elapsed += std::chrono::steady_clock::now() - start;
+				evaluations++;
+
+				if (firstPass && result != static_cast<bool>(a_record.result))
+				{
+					if (mismatches < a_options.maxReported)
+					{
+						logs::warn(
+							"Record {}: {} on {:08X} returned {} in game, {} in replay"sv,
+							a_number,
+							GetConditionName(static_cast<ConditionID>(a_record.conditionID)),
+							a_record.formID,
+							static_cast<bool>(a_record.result),
+							result);
+					}
+
+					mismatches++;
+				}
+			});
+		}
+
+		for (const auto& actor : actors)
+		{
+			RE::TESForm::RemoveForm(actor.second.get());
+		}
+
+		std::cout << std::format(
+			"replay: {} records, {} re-evaluated, {} mismatches, {} served from caches, {} skipped, {:.1f} ns/evaluation\n",
+			records,
+			evaluations / std::max(a_options.passes, 1u),
+			mismatches,
+			cached,
+			skipped,
+			evaluations ? static_cast<double>(elapsed.count()) / static_cast<double>(evaluations) : 0.0);
+
+		return mismatches ? 1 : 0;
+	}
+}
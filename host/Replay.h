@@ -0,0 +1,17 @@
+#pragma once
+
+// re-evaluates the records of a capture (see Capture.h) through the condition classes, with the mock IED and SDS
+// returning the responses that were recorded in game
+// records of conditions that read equipment from the game rather than from IED or SDS, and records served from a
+// cache or a shared result, carry nothing to re-evaluate against and are only counted
+namespace Replay
+{
+	struct Options
+	{
+		std::uint32_t passes{ 1 };        // times every record is re-evaluated, the result is compared on the first pass
+		std::uint32_t maxReported{ 10 };  // mismatches written to the log
+	};
+
+	// 0 if every re-evaluated record agrees with the capture, 1 on a mismatch, 2 if the capture can't be read
+	[[nodiscard]] int Run(const std::filesystem::path& a_path, const Options& a_options = {});
+}
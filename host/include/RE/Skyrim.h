@@ -0,0 +1,319 @@
+#pragma once
+
+// stand-in for the parts of CommonLibSSE's RE and REL headers the condition sources use, host build only
+// forms and refs are plain objects created by the host driver, lookups go through a registry in RE.cpp
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace REL
+{
+	class Version
+	{
+	public:
+		constexpr Version() noexcept = default;
+
+		constexpr Version(std::uint16_t a_major, std::uint16_t a_minor = 0, std::uint16_t a_patch = 0, std::uint16_t a_build = 0) noexcept :
+			parts{ a_major, a_minor, a_patch, a_build }
+		{
+		}
+
+		[[nodiscard]] constexpr std::uint16_t major() const noexcept { return parts[0]; }
+		[[nodiscard]] constexpr std::uint16_t minor() const noexcept { return parts[1]; }
+		[[nodiscard]] constexpr std::uint16_t patch() const noexcept { return parts[2]; }
+		[[nodiscard]] constexpr std::uint16_t build() const noexcept { return parts[3]; }
+
+	private:
+		std::array<std::uint16_t, 4> parts{};
+	};
+}
+
+namespace RE
+{
+	using FormID = std::uint32_t;
+
+	class BSString
+	{
+	public:
+		BSString() = default;
+
+		BSString(const char* a_text) :
+			text(a_text ? a_text : "")
+		{
+		}
+
+		BSString(const std::string_view& a_text) :
+			text(a_text)
+		{
+		}
+
+		[[nodiscard]] const char*   c_str() const noexcept { return text.c_str(); }
+		[[nodiscard]] const char*   data() const noexcept { return text.data(); }
+		[[nodiscard]] bool          empty() const noexcept { return text.empty(); }
+		[[nodiscard]] std::uint32_t size() const noexcept { return static_cast<std::uint32_t>(text.size()); }
+		[[nodiscard]] std::uint32_t length() const noexcept { return size(); }
+
+	private:
+		std::string text;
+	};
+
+	// case-insensitive string pool, equal names share the same pointer
+	class BSFixedString
+	{
+	public:
+		BSFixedString() = default;
+
+		BSFixedString(const char* a_text) :
+			pooled(Intern(a_text))
+		{
+		}
+
+		BSFixedString(std::string_view a_text) :
+			pooled(Intern(a_text))
+		{
+		}
+
+		BSFixedString& operator=(const char* a_text)
+		{
+			pooled = Intern(a_text);
+			return *this;
+		}
+
+		[[nodiscard]] const char*   data() const noexcept { return pooled ? pooled : ""; }
+		[[nodiscard]] const char*   c_str() const noexcept { return data(); }
+		[[nodiscard]] bool          empty() const noexcept { return !pooled || !*pooled; }
+		[[nodiscard]] std::uint32_t size() const noexcept { return pooled ? static_cast<std::uint32_t>(std::char_traits<char>::length(pooled)) : 0; }
+
+	private:
+		// nullptr for an empty string
+		[[nodiscard]] static const char* Intern(std::string_view a_text);
+
+		[[nodiscard]] static const char* Intern(const char* a_text)
+		{
+			return a_text ? Intern(std::string_view(a_text)) : nullptr;
+		}
+
+		const char* pooled{ nullptr };
+	};
+
+	namespace BSContainer
+	{
+		enum class ForEachResult
+		{
+			kContinue = 0,
+			kStop     = 1
+		};
+	}
+
+	enum class WEAPON_TYPE : std::uint8_t
+	{
+		kHandToHandMelee = 0,
+		kOneHandSword    = 1,
+		kOneHandDagger   = 2,
+		kOneHandAxe      = 3,
+		kOneHandMace     = 4,
+		kTwoHandSword    = 5,
+		kTwoHandAxe      = 6,
+		kBow             = 7,
+		kStaff           = 8,
+		kCrossbow        = 9,
+
+		kTotal = 10
+	};
+
+	enum class ActorValue : std::uint32_t
+	{
+		kNone = static_cast<std::uint32_t>(-1)
+	};
+
+	struct NiPoint3
+	{
+		float x{ 0.0f };
+		float y{ 0.0f };
+		float z{ 0.0f };
+	};
+
+	class TESForm
+	{
+	public:
+		TESForm() = default;
+
+		explicit TESForm(FormID a_formID) noexcept :
+			formID(a_formID)
+		{
+		}
+
+		TESForm(const TESForm&)            = delete;
+		TESForm& operator=(const TESForm&) = delete;
+
+		virtual ~TESForm() = default;
+
+		[[nodiscard]] FormID GetFormID() const noexcept { return formID; }
+
+		template <class T>
+		[[nodiscard]] T* As() noexcept
+		{
+			return dynamic_cast<T*>(this);
+		}
+
+		template <class T>
+		[[nodiscard]] const T* As() const noexcept
+		{
+			return dynamic_cast<const T*>(this);
+		}
+
+		// forms are found once they were added with AddForm, the caller keeps them alive
+		[[nodiscard]] static TESForm* LookupByID(FormID a_formID);
+
+		template <class T>
+		[[nodiscard]] static T* LookupByID(FormID a_formID)
+		{
+			const auto form = LookupByID(a_formID);
+			return form ? form->As<T>() : nullptr;
+		}
+
+		static void AddForm(TESForm* a_form);
+		static void RemoveForm(TESForm* a_form);
+
+		FormID formID{ 0 };
+	};
+
+	class BGSEquipSlot :
+		public TESForm
+	{
+	public:
+		using TESForm::TESForm;
+	};
+
+	class BGSEquipType
+	{
+	public:
+		virtual ~BGSEquipType() = default;
+
+		BGSEquipSlot* equipSlot{ nullptr };
+	};
+
+	class BGSKeyword :
+		public TESForm
+	{
+	public:
+		using TESForm::TESForm;
+	};
+
+	class BGSKeywordForm
+	{
+	public:
+		virtual ~BGSKeywordForm() = default;
+	};
+
+	class TESGlobal :
+		public TESForm
+	{
+	public:
+		using TESForm::TESForm;
+
+		float value{ 0.0f };
+	};
+
+	class BGSListForm :
+		public TESForm
+	{
+	public:
+		using TESForm::TESForm;
+
+		void ForEachForm(std::function<BSContainer::ForEachResult(TESForm&)> a_callback) const
+		{
+			for (const auto form : forms)
+			{
+				if (form && a_callback(*form) == BSContainer::ForEachResult::kStop)
+				{
+					return;
+				}
+			}
+		}
+
+		std::vector<TESForm*> forms;
+	};
+
+	class BGSBipedObjectForm
+	{
+	public:
+		enum class BipedObjectSlot : std::uint32_t
+		{
+			kNone   = 0,
+			kShield = 1u << 9
+		};
+	};
+
+	class TESObjectWEAP :
+		public TESForm,
+		public BGSEquipType
+	{
+	public:
+		using TESForm::TESForm;
+
+		[[nodiscard]] WEAPON_TYPE GetWeaponType() const noexcept { return weaponType; }
+		[[nodiscard]] bool        IsBound() const noexcept { return bound; }
+
+		WEAPON_TYPE weaponType{ WEAPON_TYPE::kHandToHandMelee };
+		bool        bound{ false };
+	};
+
+	class TESObjectARMO :
+		public TESForm
+	{
+	public:
+		using TESForm::TESForm;
+
+		[[nodiscard]] bool IsShield() const noexcept { return shield; }
+
+		bool shield{ false };
+	};
+
+	class TESObjectREFR :
+		public TESForm
+	{
+	public:
+		using TESForm::TESForm;
+
+		[[nodiscard]] bool Is3DLoaded() const noexcept { return loaded3D; }
+
+		bool loaded3D{ true };
+	};
+
+	class Actor :
+		public TESObjectREFR
+	{
+	public:
+		using TESObjectREFR::TESObjectREFR;
+
+		[[nodiscard]] TESForm* GetEquippedObject(bool a_leftHand) const noexcept
+		{
+			return equippedObjects[a_leftHand ? 1 : 0];
+		}
+
+		[[nodiscard]] TESObjectARMO* GetWornArmor(BGSBipedObjectForm::BipedObjectSlot a_slot, [[maybe_unused]] bool a_noInit = false) const noexcept
+		{
+			return a_slot == BGSBipedObjectForm::BipedObjectSlot::kShield ? wornShield : nullptr;
+		}
+
+		std::array<TESForm*, 2> equippedObjects{};  // right, left
+		TESObjectARMO*          wornShield{ nullptr };
+	};
+
+	class hkbContext
+	{
+	};
+
+	class hkbClipGenerator
+	{
+	};
+
+	// milliseconds since the host process started
+	[[nodiscard]] std::uint32_t GetDurationOfApplicationRunTime() noexcept;
+}
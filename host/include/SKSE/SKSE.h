@@ -0,0 +1,119 @@
+#pragma once
+
+// stand-in for the parts of CommonLibSSE's SKSE headers the condition sources use, host build only
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "RE/Skyrim.h"
+
+namespace SKSE
+{
+	namespace WinAPI
+	{
+	}
+
+	namespace stl
+	{
+		template <class E>
+		[[nodiscard]] constexpr auto to_underlying(E a_value) noexcept  //
+			requires std::is_enum_v<E>
+		{
+			return static_cast<std::underlying_type_t<E>>(a_value);
+		}
+	}
+
+	namespace log
+	{
+		template <class... Args>
+		void trace(spdlog::format_string_t<Args...> a_fmt, Args&&... a_args)
+		{
+			spdlog::trace(a_fmt, std::forward<Args>(a_args)...);
+		}
+
+		template <class... Args>
+		void debug(spdlog::format_string_t<Args...> a_fmt, Args&&... a_args)
+		{
+			spdlog::debug(a_fmt, std::forward<Args>(a_args)...);
+		}
+
+		template <class... Args>
+		void info(spdlog::format_string_t<Args...> a_fmt, Args&&... a_args)
+		{
+			spdlog::info(a_fmt, std::forward<Args>(a_args)...);
+		}
+
+		template <class... Args>
+		void warn(spdlog::format_string_t<Args...> a_fmt, Args&&... a_args)
+		{
+			spdlog::warn(a_fmt, std::forward<Args>(a_args)...);
+		}
+
+		template <class... Args>
+		void error(spdlog::format_string_t<Args...> a_fmt, Args&&... a_args)
+		{
+			spdlog::error(a_fmt, std::forward<Args>(a_args)...);
+		}
+
+		template <class... Args>
+		void critical(spdlog::format_string_t<Args...> a_fmt, Args&&... a_args)
+		{
+			spdlog::critical(a_fmt, std::forward<Args>(a_args)...);
+		}
+
+		// the working directory stands in for the SKSE log directory
+		[[nodiscard]] inline std::optional<std::filesystem::path> log_directory()
+		{
+			return std::filesystem::current_path();
+		}
+	}
+
+	using PluginHandle = std::uint32_t;
+
+	[[nodiscard]] constexpr PluginHandle GetPluginHandle() noexcept
+	{
+		return 0;
+	}
+
+	class PluginDeclaration
+	{
+	public:
+		[[nodiscard]] static const PluginDeclaration* GetSingleton() noexcept
+		{
+			static const PluginDeclaration singleton;
+			return std::addressof(singleton);
+		}
+
+		[[nodiscard]] std::string_view GetName() const noexcept { return "OpenAnimationReplacer-IEDConditionExtensions"; }
+		[[nodiscard]] std::string_view GetAuthor() const noexcept { return "SlavicPotato"; }
+		[[nodiscard]] REL::Version     GetVersion() const noexcept { return { 1, 1, 0 }; }
+	};
+}
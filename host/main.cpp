@@ -0,0 +1,541 @@
+#include <barrier>
+#include <iostream>
+
+#include "Bench.h"
+#include "Conditions.h"
+#include "Hooks.h"
+#include "Interface.h"
+#include "MockOAR.h"
+#include "Mocks.h"
+#include "Population.h"
+#include "RandomConditions.h"
+#include "Replay.h"
+#include "SettingsSnapshot.h"
+
+// runs the conditions outside the game against the mock IED, SDS and OAR, see the README for the commands
+namespace
+{
+	using namespace Conditions;
+
+	class Options
+	{
+	public:
+		Options(int a_argc, char* a_argv[])
+		{
+			for (int i = 1; i < a_argc; i++)
+			{
+				const std::string_view argument = a_argv[i];
+
+				if (argument.starts_with("--"))
+				{
+					const auto next = i + 1 < a_argc && !std::string_view(a_argv[i + 1]).starts_with("--") ? a_argv[++i] : "";
+					values.insert_or_assign(std::string(argument.substr(2)), next);
+				}
+				else if (command.empty())
+				{
+					command = argument;
+				}
+				else
+				{
+					positional.emplace_back(argument);
+				}
+			}
+		}
+
+		[[nodiscard]] bool Has(std::string_view a_name) const
+		{
+			return values.contains(std::string(a_name));
+		}
+
+		[[nodiscard]] std::uint32_t GetUInt(std::string_view a_name, std::uint32_t a_default) const
+		{
+			const auto it = values.find(std::string(a_name));
+			if (it == values.end() || it->second.empty())
+			{
+				return a_default;
+			}
+
+			return static_cast<std::uint32_t>(std::stoul(it->second));
+		}
+
+		[[nodiscard]] double GetDouble(std::string_view a_name, double a_default) const
+		{
+			const auto it = values.find(std::string(a_name));
+			if (it == values.end() || it->second.empty())
+			{
+				return a_default;
+			}
+
+			return std::stod(it->second);
+		}
+
+		[[nodiscard]] std::string GetString(std::string_view a_name, std::string_view a_default) const
+		{
+			const auto it = values.find(std::string(a_name));
+			return it == values.end() || it->second.empty() ? std::string(a_default) : it->second;
+		}
+
+		std::string                        command;
+		std::vector<std::string>           positional;
+		std::map<std::string, std::string> values;
+	};
+
+	template <class T>
+	void RegisterCondition()
+	{
+		if (OAR_API::Conditions::AddCustomCondition<T>() != OAR_API::Conditions::APIResult::OK)
+		{
+			logs::error("Failed to register condition {}!", T::CONDITION_NAME);
+		}
+	}
+
+	// the registration and interface queries of the plugin's kPostPostLoad and kDataLoaded handlers
+	bool Initialize(const Options& a_options)
+	{
+		auto& settings = Mocks::GetSettings();
+
+		settings.latency             = a_options.GetUInt("latency", 0);
+		settings.iedInterfaceVersion = a_options.GetUInt("ied-version", 1);
+		settings.hasIED              = !a_options.Has("no-ied");
+		settings.hasSDS              = !a_options.Has("no-sds");
+
+		Mocks::Install();
+
+		if (!OAR_API::Conditions::GetAPI(OAR_API::Conditions::InterfaceVersion::V2))
+		{
+			logs::error("Failed to request Open Animation Replacer API"sv);
+			return false;
+		}
+
+		RegisterCondition<IEDHasEquipmentSlot>();
+		RegisterCondition<IEDIsBoundWeaponEquipped>();
+		RegisterCondition<IEDEquippedWeaponTraitsCondition>();
+
+		if (auto result = PluginInterfaceBase::query_interface<PluginInterfaceIED>())
+		{
+			g_interfaceIED = result.intfc;
+
+			RegisterCondition<IEDNodePlacementCondition>();
+			RegisterCondition<IEDNodesPlacementCondition>();
+			RegisterCondition<IEDNodeEquippedPlacementCondition>();
+			RegisterCondition<IEDNodeParentNameCondition>();
+			RegisterCondition<IEDNodeParentNameInListCondition>();
+			RegisterCondition<IEDPluginOptionCondition>();
+		}
+
+		if (auto result = PluginInterfaceBase::query_interface<PluginInterfaceSDS>())
+		{
+			g_interfaceSDS = result.intfc;
+
+			RegisterCondition<SDSShieldOnBackEnabledCondition>();
+			RegisterCondition<SDSWeaponNodeSharingDisabledCondition>();
+		}
+
+		SettingsSnapshot::Refresh();
+
+		return true;
+	}
+
+	// the MainUpdate hook's per-frame work
+	void EndFrame()
+	{
+		SettingsSnapshot::Update();
+		Hooks::AdvanceFrameEpoch();
+	}
+
+	std::vector<std::unique_ptr<ICondition>> CreateConditions(
+		const Population&                a_population,
+		std::uint32_t                    a_instances,
+		std::mt19937&                    a_rng,
+		const RandomConditions::Options& a_options = {})
+	{
+		std::vector<std::unique_ptr<ICondition>> result;
+
+		for (std::uint32_t i = 0; i < stl::to_underlying(ConditionID::kTotal); i++)
+		{
+			for (std::uint32_t j = 0; j < a_instances; j++)
+			{
+				auto condition = RandomConditions::Create(static_cast<ConditionID>(i), a_population, a_rng, a_options);
+				if (!condition)
+				{
+					break;
+				}
+
+				result.emplace_back(std::move(condition));
+			}
+		}
+
+		return result;
+	}
+
+	// what an edit in OAR's UI does: a numeric component switches between a static value and a global, then PostInitialize runs
+	// returns the number of actors the edited condition disagrees with a copy loaded from its serialization on
+	std::uint64_t EditAndCompare(ICondition& a_condition, const Population& a_population, std::mt19937& a_rng)
+	{
+		std::vector<INumericConditionComponent*> numerics;
+
+		for (std::uint32_t i = 0; i < a_condition.GetNumComponents(); i++)
+		{
+			const auto component = a_condition.GetComponent(i);
+			if (component->GetType() == ConditionComponentType::kNumeric && std::string_view(component->GetName().c_str()) != "Cache (ms)"sv)
+			{
+				numerics.emplace_back(static_cast<INumericConditionComponent*>(component));
+			}
+		}
+
+		if (numerics.empty())
+		{
+			return 0;
+		}
+
+		const auto component = numerics[std::uniform_int_distribution<std::size_t>(0, numerics.size() - 1)(a_rng)];
+		if (a_rng() & 1)
+		{
+			component->SetGlobalVariable(RE::TESForm::LookupByID<RE::TESGlobal>(Population::GLOBAL));
+		}
+		else
+		{
+			component->SetStaticValue(static_cast<float>(std::uniform_int_distribution<std::uint32_t>(0, 18)(a_rng)));
+		}
+
+		a_condition.PostInitialize();
+
+		rapidjson::Document document(rapidjson::kObjectType);
+		a_condition.Serialize(std::addressof(document), std::addressof(document.GetAllocator()), nullptr);
+
+		const auto copy = MockOAR::LoadCondition(document);
+
+		std::uint64_t result = 0;
+
+		for (const auto actor : a_population.GetActors())
+		{
+			result += a_condition.Evaluate(actor, nullptr) != copy->Evaluate(actor, nullptr);
+		}
+
+		return result;
+	}
+
+	// every condition type against the population, each frame twice: the second pass is served by the per-frame caches
+	// and has to agree with the first, and a frame without changes has to agree with the one before it
+	// frames that change the population also edit a few conditions, which then have to agree with a reloaded copy
+	int RunSmoke(const Options& a_options)
+	{
+		const auto actors    = a_options.GetUInt("actors", 64);
+		const auto instances = a_options.GetUInt("instances", 4);
+		const auto frames    = a_options.GetUInt("frames", 100);
+		const auto edits     = a_options.GetUInt("edits", 2);
+		const auto seed      = a_options.GetUInt("seed", 1);
+
+		Population   population(actors, seed);
+		std::mt19937 rng(seed);
+
+		const auto conditions = CreateConditions(population, instances, rng);
+
+		const auto evaluate = [&](std::vector<bool>& a_out) {
+			a_out.clear();
+
+			for (const auto actor : population.GetActors())
+			{
+				for (const auto& condition : conditions)
+				{
+					a_out.push_back(condition->Evaluate(actor, nullptr));
+				}
+			}
+		};
+
+		const auto compare = [](const std::vector<bool>& a_lhs, const std::vector<bool>& a_rhs) {
+			std::uint64_t result = 0;
+
+			for (std::size_t i = 0; i < a_lhs.size(); i++)
+			{
+				result += a_lhs[i] != a_rhs[i];
+			}
+
+			return result;
+		};
+
+		std::vector<bool> previous;
+		std::vector<bool> current;
+		std::vector<bool> cached;
+
+		std::uint64_t evaluations = 0;
+		std::uint64_t trueResults = 0;
+		std::uint64_t mismatches  = 0;
+
+		for (std::uint32_t frame = 0; frame < frames; frame++)
+		{
+			const bool mutate = frame % 2 == 0;
+			if (mutate)
+			{
+				population.Mutate(actors / 8 + 1);
+			}
+
+			EndFrame();
+
+			if (mutate)
+			{
+				for (std::uint32_t i = 0; i < edits && !conditions.empty(); i++)
+				{
+					const auto index = std::uniform_int_distribution<std::size_t>(0, conditions.size() - 1)(rng);
+					mismatches += EditAndCompare(*conditions[index], population, rng);
+				}
+			}
+
+			evaluate(current);
+			evaluate(cached);
+
+			mismatches += compare(current, cached);
+
+			if (!mutate && !previous.empty())
+			{
+				mismatches += compare(current, previous);
+			}
+
+			evaluations += current.size() * 2;
+			trueResults += std::ranges::count(current, true);
+
+			std::swap(previous, current);
+		}
+
+		std::cout << std::format(
+			"smoke: {} conditions x {} actors, {} frames, {} evaluations, {} true, {} mismatches\n",
+			conditions.size(),
+			population.GetActors().size(),
+			frames,
+			evaluations,
+			trueResults,
+			mismatches);
+
+		return mismatches ? 1 : 0;
+	}
+
+	struct StressResult
+	{
+		double        p50Us{ 0 };
+		double        p99Us{ 0 };
+		double        evaluationsPerSecond{ 0 };
+		std::uint64_t trueResults{ 0 };
+	};
+
+	// a_threads workers evaluate every condition against their share of the actors each frame, the main thread
+	// rerolls a_mutate actors between frames the way equip events and IED updates arrive in game
+	StressResult RunStressFrames(
+		Population&                                     a_population,
+		const std::vector<std::unique_ptr<ICondition>>& a_conditions,
+		std::uint32_t                                   a_threads,
+		std::uint32_t                                   a_frames,
+		std::uint32_t                                   a_mutate)
+	{
+		using clock_type = std::chrono::steady_clock;
+
+		const auto& actors = a_population.GetActors();
+
+		std::barrier                      frameSync(a_threads + 1);
+		std::atomic<bool>                 done{ false };
+		std::atomic<std::uint64_t>        trueResults{ 0 };
+		std::vector<clock_type::duration> frameTimes;
+		frameTimes.reserve(a_frames);
+
+		// each worker owns a contiguous range of actors, like the animation jobs that update one graph each
+		std::vector<std::jthread> workers;
+		for (std::uint32_t t = 0; t < a_threads; t++)
+		{
+			workers.emplace_back([&, t] {
+				const auto first = actors.size() * t / a_threads;
+				const auto last  = actors.size() * (t + 1) / a_threads;
+
+				std::uint64_t count = 0;
+
+				for (;;)
+				{
+					frameSync.arrive_and_wait();
+					if (done.load(std::memory_order_relaxed))
+					{
+						break;
+					}
+
+					for (auto i = first; i < last; i++)
+					{
+						for (const auto& condition : a_conditions)
+						{
+							count += condition->Evaluate(actors[i], nullptr);
+						}
+					}
+
+					frameSync.arrive_and_wait();
+				}
+
+				trueResults.fetch_add(count, std::memory_order_relaxed);
+			});
+		}
+
+		clock_type::duration elapsed{ 0 };
+
+		for (std::uint32_t frame = 0; frame < a_frames; frame++)
+		{
+			if (a_mutate)
+			{
+				a_population.Mutate(a_mutate);
+			}
+
+			EndFrame();
+
+			const auto frameStart = clock_type::now();
+
+			frameSync.arrive_and_wait();
+			frameSync.arrive_and_wait();
+
+			frameTimes.emplace_back(clock_type::now() - frameStart);
+			elapsed += frameTimes.back();
+		}
+
+		done.store(true, std::memory_order_relaxed);
+		frameSync.arrive_and_wait();
+		workers.clear();
+
+		std::ranges::sort(frameTimes);
+
+		const auto toUs = [](clock_type::duration a_duration) {
+			return std::chrono::duration<double, std::micro>(a_duration).count();
+		};
+
+		const auto evaluations = static_cast<double>(actors.size() * a_conditions.size()) * a_frames;
+
+		StressResult result;
+		result.p50Us                = toUs(frameTimes[frameTimes.size() / 2]);
+		result.p99Us                = toUs(frameTimes[std::min(frameTimes.size() - 1, frameTimes.size() * 99 / 100)]);
+		result.evaluationsPerSecond = evaluations / std::chrono::duration<double>(elapsed).count();
+		result.trueResults          = trueResults.load();
+
+		return result;
+	}
+
+	// throughput and frame time percentiles with 1, 2, 4 .. --threads workers
+	int RunStress(const Options& a_options)
+	{
+		const auto actors     = std::max(a_options.GetUInt("actors", 1000), 1u);
+		const auto instances  = std::max(a_options.GetUInt("instances", 16), 1u);
+		const auto maxThreads = std::max(a_options.GetUInt("threads", std::max(std::thread::hardware_concurrency(), 1u)), 1u);
+		const auto frames     = std::max(a_options.GetUInt("frames", 200), 1u);
+		const auto mutate     = a_options.GetUInt("mutate", actors / 64);
+		const auto seed       = a_options.GetUInt("seed", 1);
+
+		Population   population(actors, seed);
+		std::mt19937 rng(seed);
+
+		const RandomConditions::Options conditionOptions{
+			.globalPercent = a_options.GetUInt("globals", 10),
+			.cacheTime     = a_options.GetUInt("cache-ms", 0)
+		};
+
+		const auto conditions = CreateConditions(population, instances, rng, conditionOptions);
+
+		std::cout << std::format(
+			"stress: {} actors x {} conditions, {} frames, {} actors changed per frame, {} ns IED/SDS latency\n",
+			population.GetActors().size(),
+			conditions.size(),
+			frames,
+			mutate,
+			Mocks::GetSettings().latency);
+
+		for (std::uint32_t threads = 1;; threads = std::min(threads * 2, maxThreads))
+		{
+			const auto result = RunStressFrames(population, conditions, threads, frames, mutate);
+
+			std::cout << std::format(
+				"  {:>3} threads: {:>12.0f} evaluations/s, frame p50 {:>9.1f} us, p99 {:>9.1f} us, {} true\n",
+				threads,
+				result.evaluationsPerSecond,
+				result.p50Us,
+				result.p99Us,
+				result.trueResults);
+
+			if (threads == maxThreads)
+			{
+				break;
+			}
+		}
+
+		return 0;
+	}
+
+	void PrintUsage()
+	{
+		std::cout <<
+			"usage: OARIEDHost <command> [options]\n"
+			"\n"
+			"commands:\n"
+			"  smoke    evaluate every condition type against a synthetic population and check the caches agree\n"
+			"           --actors N (64) --instances N (4) --frames N (100) --edits N (2) --seed N (1)\n"
+			"  stress   evaluate from 1, 2, 4 .. N worker threads and report evaluations/s and frame time percentiles\n"
+			"           --actors N (1000) --instances N (16) --threads N (cores) --frames N (200) --mutate N (actors / 64)\n"
+			"           --globals PERCENT (10) --cache-ms N (0) --seed N (1)\n"
+			"  bench    time every condition type against the player and compare ns/op and allocations/op with a baseline\n"
+			"           --baseline FILE (host/baseline.ini) --iterations N (100000) --threshold PERCENT (10) --save\n"
+			"  replay   re-evaluate the records of a capture file against the IED and SDS responses it holds\n"
+			"           <file> --passes N (1)\n"
+			"\n"
+			"mock options:\n"
+			"  --latency NS        busy-wait added to every IED and SDS call (0)\n"
+			"  --ied-version N     interface version the mock IED reports (1)\n"
+			"  --no-ied, --no-sds  leave the plugin out\n"
+			"  --verbose           log at info level\n";
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	const Options options(a_argc, a_argv);
+
+	spdlog::set_pattern("[%^%L%$] %v");
+	spdlog::set_level(options.Has("verbose") ? spdlog::level::info : spdlog::level::warn);
+
+	if (options.command.empty() || options.command == "help")
+	{
+		PrintUsage();
+		return options.command.empty() ? 2 : 0;
+	}
+
+	if (!Initialize(options))
+	{
+		return 1;
+	}
+
+	if (options.command == "smoke")
+	{
+		return RunSmoke(options);
+	}
+
+	if (options.command == "stress")
+	{
+		return RunStress(options);
+	}
+
+	if (options.command == "bench")
+	{
+		const Population population(1, 1);
+
+		return Bench::Run(
+			population,
+			{ .baseline   = options.GetString("baseline", "host/baseline.ini"),
+			  .iterations = options.GetUInt("iterations", 100000),
+			  .threshold  = options.GetDouble("threshold", 10.0),
+			  .save       = options.Has("save") });
+	}
+
+	if (options.command == "replay")
+	{
+		if (options.positional.empty())
+		{
+			PrintUsage();
+			return 2;
+		}
+
+		return Replay::Run(options.positional.front(), { .passes = options.GetUInt("passes", 1) });
+	}
+
+	std::cerr << std::format("unknown command '{}'\n", options.command);
+	PrintUsage();
+
+	return 2;
+}
@@ -0,0 +1,52 @@
+#include "ModuleLoader.h"
+
+namespace
+{
+#if defined(_WIN32)
+	class DefaultModuleLoader :
+		public ModuleLoader
+	{
+		using native_handle = decltype(GetModuleHandle(std::declval<const char*>()));
+
+	public:
+		module_handle GetModule(const char* a_name) const override
+		{
+			return GetModuleHandle(a_name);
+		}
+
+		void* GetSymbol(module_handle a_module, const char* a_name) const override
+		{
+			return a_module ? reinterpret_cast<void*>(GetProcAddress(static_cast<native_handle>(a_module), a_name)) : nullptr;
+		}
+	};
+#else
+	// no plugin modules outside of Windows, the host build installs its own loader
+	class DefaultModuleLoader :
+		public ModuleLoader
+	{
+	public:
+		module_handle GetModule([[maybe_unused]] const char* a_name) const override
+		{
+			return nullptr;
+		}
+
+		void* GetSymbol([[maybe_unused]] module_handle a_module, [[maybe_unused]] const char* a_name) const override
+		{
+			return nullptr;
+		}
+	};
+#endif
+
+	DefaultModuleLoader s_defaultLoader;
+	ModuleLoader*       s_loader = std::addressof(s_defaultLoader);
+}
+
+ModuleLoader* ModuleLoader::Get() noexcept
+{
+	return s_loader;
+}
+
+void ModuleLoader::Set(ModuleLoader* a_loader) noexcept
+{
+	s_loader = a_loader ? a_loader : std::addressof(s_defaultLoader);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// resolves plugin modules and their exported entry points
+// the default loader goes through the Windows loader, a different one can be installed
+// with ModuleLoader::Set (the host build serves its mock plugins that way)
+class ModuleLoader
+{
+public:
+	using module_handle = void*;
+
+	virtual ~ModuleLoader() = default;
+
+	[[nodiscard]] virtual module_handle GetModule(const char* a_name) const                      = 0;
+	[[nodiscard]] virtual void*         GetSymbol(module_handle a_module, const char* a_name) const = 0;
+
+	[[nodiscard]] static ModuleLoader* Get() noexcept;
+	static void                        Set(ModuleLoader* a_loader) noexcept;  // nullptr restores the default loader
+};
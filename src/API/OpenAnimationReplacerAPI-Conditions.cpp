@@ -1,5 +1,7 @@
 #include "OpenAnimationReplacerAPI-Conditions.h"
 
+#include "ModuleLoader.h"
+
 OAR_API::Conditions::IConditionsInterface* g_oarConditionsInterface = nullptr;
 
 namespace OAR_API::Conditions
@@ -11,8 +13,9 @@ namespace OAR_API::Conditions
 			return g_oarConditionsInterface;
 		}
 
-		const auto pluginHandle       = GetModuleHandle("OpenAnimationReplacer.dll");
-		const auto requestAPIFunction = static_cast<_RequestPluginAPI_Conditions>(GetProcAddress(pluginHandle, "RequestPluginAPI_Conditions"));
+		const auto loader             = ModuleLoader::Get();
+		const auto pluginHandle       = loader->GetModule("OpenAnimationReplacer.dll");
+		const auto requestAPIFunction = reinterpret_cast<_RequestPluginAPI_Conditions>(loader->GetSymbol(pluginHandle, "RequestPluginAPI_Conditions"));
 		if (!requestAPIFunction)
 		{
 			return nullptr;
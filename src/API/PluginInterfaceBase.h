@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <type_traits>
 
+#include "ModuleLoader.h"
+
 enum class PluginInterfaceQueryErrorState : std::uint32_t
 {
 	kNone                = 0,
@@ -44,7 +46,9 @@ public:
 			return result;
 		}
 
-		auto handle = GetModuleHandle(a_dll);
+		const auto loader = ModuleLoader::Get();
+
+		auto handle = loader->GetModule(a_dll);
 		if (!handle)
 		{
 			result.error = PluginInterfaceQueryErrorState::kDllNotLoaded;
@@ -54,7 +58,13 @@ public:
 
 		using func_t = T* (*)();
 
-		func_t func = reinterpret_cast<func_t>(GetProcAddress(handle, "SKMP_GetPluginInterface"));
+		func_t func = reinterpret_cast<func_t>(loader->GetSymbol(handle, "SKMP_GetPluginInterface"));
+		if (!func)
+		{
+			result.error = PluginInterfaceQueryErrorState::kEntryPointNotFound;
+
+			return result;
+		}
 
 		auto intfc = func();
 		if (!intfc)
@@ -0,0 +1,570 @@
+#include "ActorCache.h"
+
+#include "Hooks.h"
+#include "Interface.h"
+#include "LogRateLimiter.h"
+
+namespace ActorCache
+{
+	namespace
+	{
+		constexpr RE::FormID PLAYER_FORM_ID = 0x14;
+
+		Entry                                                  s_playerEntry;
+		std::shared_mutex                                      s_lock;
+		std::unordered_map<RE::FormID, std::unique_ptr<Entry>> s_entries;
+
+		LogRateLimiter s_uncachedGearNodeLog{ 10s };
+	}
+
+	template <class Tf>
+	WeaponPlacementID PlacementCache::Get(std::uint32_t a_slot, Tf a_fetch)
+	{
+		const auto epoch = Hooks::GetFrameEpoch();
+		const auto bit   = std::uint64_t(1) << a_slot;
+
+		auto current = state.load(std::memory_order_acquire);
+		if (static_cast<std::uint32_t>(current >> 32) == epoch && (current & bit) != 0)
+		{
+			WeaponPlacementID result;
+			if (Load(a_slot, epoch, result))
+			{
+				return result;
+			}
+		}
+
+		const auto result = a_fetch();
+		Store(a_slot, epoch, result);
+
+		Publish(epoch, bit, current);
+
+		return result;
+	}
+
+	bool PlacementCache::Load(std::uint32_t a_slot, std::uint32_t a_epoch, WeaponPlacementID& a_out) const noexcept
+	{
+		const auto value = placements[a_slot].load(std::memory_order_relaxed);
+		if ((value >> 8) != (a_epoch & 0xFF))
+		{
+			return false;
+		}
+
+		a_out = static_cast<WeaponPlacementID>(value & 0xFF);
+
+		return true;
+	}
+
+	void PlacementCache::Store(std::uint32_t a_slot, std::uint32_t a_epoch, WeaponPlacementID a_value) noexcept
+	{
+		placements[a_slot].store(static_cast<std::uint16_t>(((a_epoch & 0xFF) << 8) | stl::to_underlying(a_value)), std::memory_order_relaxed);
+	}
+
+	void PlacementCache::Publish(std::uint32_t a_epoch, std::uint64_t a_bits, std::uint64_t a_current)
+	{
+		// a slot published by another thread for the same epoch holds an equally fresh value, so the last writer wins
+		// a writer that fetched before a frame advance must not move the epoch back or mark the newer frame's slots as its own
+		for (;;)
+		{
+			const auto currentEpoch = static_cast<std::uint32_t>(a_current >> 32);
+			if (static_cast<std::int32_t>(a_epoch - currentEpoch) < 0)
+			{
+				break;
+			}
+
+			const auto desired = currentEpoch == a_epoch ?
+			                         a_current | a_bits :
+			                         (static_cast<std::uint64_t>(a_epoch) << 32) | a_bits;
+
+			if (state.compare_exchange_weak(a_current, desired, std::memory_order_release, std::memory_order_acquire))
+			{
+				break;
+			}
+		}
+	}
+
+	WeaponPlacementID PlacementCache::GetForGearNode(RE::TESObjectREFR* a_refr, GearNodeID a_id)
+	{
+		const auto slot = stl::to_underlying(a_id);
+		if (slot >= GEAR_NODE_COUNT)
+		{
+			s_uncachedGearNodeLog.Log(spdlog::level::debug, "Gear node ID {} is out of range, placement hint is not cached", slot);
+			return g_interfaceIED->GetPlacementHintForGearNode(a_refr, a_id);
+		}
+
+		return Get(slot, [&] {
+			return g_interfaceIED->GetPlacementHintForGearNode(a_refr, a_id);
+		});
+	}
+
+	void PlacementCache::GetForGearNodes(RE::TESObjectREFR* a_refr, std::uint32_t a_mask, GearNodePlacements& a_out)
+	{
+		const auto epoch   = Hooks::GetFrameEpoch();
+		const auto current = state.load(std::memory_order_acquire);
+		const auto valid   = static_cast<std::uint32_t>(current >> 32) == epoch ? static_cast<std::uint32_t>(current) : 0;
+
+		const auto mask  = a_mask & GEAR_NODE_MASK;
+		auto       stale = mask & ~valid;
+
+		for (auto bits = mask & valid; bits; bits &= bits - 1)
+		{
+			const auto slot = static_cast<std::uint32_t>(std::countr_zero(bits));
+			if (!Load(slot, epoch, a_out[slot]))
+			{
+				stale |= std::uint32_t(1) << slot;
+			}
+		}
+
+		for (auto bits = stale; bits; bits &= bits - 1)
+		{
+			const auto slot = static_cast<std::uint32_t>(std::countr_zero(bits));
+
+			a_out[slot] = g_interfaceIED->GetPlacementHintForGearNode(a_refr, static_cast<GearNodeID>(slot));
+			Store(slot, epoch, a_out[slot]);
+		}
+
+		if (stale)
+		{
+			Publish(epoch, stale, current);
+		}
+	}
+
+	WeaponPlacementID PlacementCache::GetForEquippedWeapon(RE::TESObjectREFR* a_refr, bool a_leftHand)
+	{
+		return Get(a_leftHand ? SLOT_EQUIPPED_LEFT : SLOT_EQUIPPED_RIGHT, [&] {
+			return g_interfaceIED->GetPlacementHintForEquippedWeapon(a_refr, a_leftHand);
+		});
+	}
+
+	bool ShieldOnBackState::Get(RE::Actor* a_actor)
+	{
+		auto current = state.load(std::memory_order_relaxed);
+		if ((current & VALUE_MASK) != UNKNOWN)
+		{
+			return (current & VALUE_MASK) != 0;
+		}
+
+		const auto result = g_interfaceSDS->GetShieldOnBackEnabled(a_actor);
+
+		// events can arrive before the change is fully applied, don't keep what was read during that frame
+		if (Hooks::GetFrameEpoch() == settleEpoch.load(std::memory_order_relaxed))
+		{
+			return result;
+		}
+
+		// an event delivered while fetching bumped the generation and takes precedence
+		state.compare_exchange_strong(current, (current & ~VALUE_MASK) | static_cast<std::uint32_t>(result), std::memory_order_relaxed);
+
+		return result;
+	}
+
+	void ShieldOnBackState::Set(bool a_value) noexcept
+	{
+		Replace(static_cast<std::uint32_t>(a_value));
+	}
+
+	void ShieldOnBackState::Invalidate() noexcept
+	{
+		settleEpoch.store(Hooks::GetFrameEpoch(), std::memory_order_relaxed);
+		Replace(UNKNOWN);
+	}
+
+	void ShieldOnBackState::Replace(std::uint32_t a_value) noexcept
+	{
+		auto current = state.load(std::memory_order_relaxed);
+		while (!state.compare_exchange_weak(current, ((current & ~VALUE_MASK) + GENERATION_ONE) | a_value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	EquipmentSnapshot::Hand EquipmentSnapshot::Get(RE::Actor* a_actor, bool a_leftHand)
+	{
+		const auto index = a_leftHand ? 1 : 0;
+
+		{
+			const std::shared_lock sharedLock(lock);
+
+			if (builtGeneration == generation.load(std::memory_order_acquire))
+			{
+				return hands[index];
+			}
+		}
+
+		const std::unique_lock uniqueLock(lock);
+
+		const auto currentGeneration = generation.load(std::memory_order_acquire);
+		if (builtGeneration == currentGeneration)
+		{
+			return hands[index];
+		}
+
+		hands = { MakeHand(a_actor, false), MakeHand(a_actor, true) };
+
+		// equip events can arrive before the change is fully applied, don't keep what was read during that frame
+		if (Hooks::GetFrameEpoch() != settleEpoch.load(std::memory_order_relaxed))
+		{
+			builtGeneration = currentGeneration;
+		}
+
+		return hands[index];
+	}
+
+	void EquipmentSnapshot::Invalidate() noexcept
+	{
+		settleEpoch.store(Hooks::GetFrameEpoch(), std::memory_order_relaxed);
+		generation.fetch_add(1, std::memory_order_release);
+	}
+
+	void EquipmentSnapshot::SetWornShield(bool a_worn) noexcept
+	{
+		wornShield.store(static_cast<std::int8_t>(a_worn), std::memory_order_relaxed);
+	}
+
+	void EquipmentSnapshot::ResetWornShield() noexcept
+	{
+		wornShield.store(UNKNOWN, std::memory_order_relaxed);
+	}
+
+	bool EquipmentSnapshot::IsShieldWorn(RE::Actor* a_actor) const
+	{
+		const auto recorded = wornShield.load(std::memory_order_relaxed);
+		if (recorded != UNKNOWN)
+		{
+			return recorded != 0;
+		}
+
+		return a_actor->GetWornArmor(RE::BGSBipedObjectForm::BipedObjectSlot::kShield, true) != nullptr;
+	}
+
+	EquipmentSnapshot::Hand EquipmentSnapshot::MakeHand(RE::Actor* a_actor, bool a_leftHand) const
+	{
+		Hand result;
+
+		const auto object = a_actor->GetEquippedObject(a_leftHand);
+		if (!object)
+		{
+			// shields are worn armor rather than an equipped hand object
+			if (a_leftHand && IsShieldWorn(a_actor))
+			{
+				result.traits = kTraitEquipped | kTraitShield;
+			}
+
+			return result;
+		}
+
+		result.object = object;
+		result.traits = kTraitEquipped;
+
+		if (const auto equipType = object->As<RE::BGSEquipType>())
+		{
+			result.equipSlot = equipType->equipSlot;
+		}
+
+		if (result.equipSlot)
+		{
+			result.traits |= kTraitHasEquipSlot;
+		}
+
+		if (const auto weapon = object->As<RE::TESObjectWEAP>())
+		{
+			result.weaponType = weapon->GetWeaponType();
+			result.isWeapon   = true;
+			result.isBound    = weapon->IsBound();
+
+			result.traits |= kTraitWeapon | (1u << (kTraitWeaponTypeShift + stl::to_underlying(result.weaponType)));
+
+			if (result.isBound)
+			{
+				result.traits |= kTraitBound;
+			}
+
+			switch (result.weaponType)
+			{
+			case RE::WEAPON_TYPE::kOneHandSword:
+			case RE::WEAPON_TYPE::kOneHandDagger:
+			case RE::WEAPON_TYPE::kOneHandAxe:
+			case RE::WEAPON_TYPE::kOneHandMace:
+			case RE::WEAPON_TYPE::kStaff:
+				result.traits |= kTraitOneHanded;
+				break;
+			case RE::WEAPON_TYPE::kTwoHandSword:
+			case RE::WEAPON_TYPE::kTwoHandAxe:
+				result.traits |= kTraitTwoHanded;
+				break;
+			case RE::WEAPON_TYPE::kBow:
+			case RE::WEAPON_TYPE::kCrossbow:
+				result.traits |= kTraitTwoHanded | kTraitRanged;
+				break;
+			default:
+				break;
+			}
+		}
+		else if (const auto armor = object->As<RE::TESObjectARMO>(); armor && armor->IsShield())
+		{
+			result.traits |= kTraitShield;
+		}
+
+		return result;
+	}
+
+	std::uint8_t Eligibility::Get(RE::Actor* a_actor, std::uint8_t a_flags)
+	{
+		const auto epoch   = Hooks::GetFrameEpoch();
+		auto       current = state.load(std::memory_order_acquire);
+
+		const auto builtEpoch = static_cast<std::uint32_t>(current >> 32);
+		const auto flags      = static_cast<std::uint8_t>(current);
+
+		// flags the actor has stay known until the next event, missing ones expire after a few frames
+		std::uint8_t known = 0;
+		if (!(current & SETTLING) || builtEpoch == epoch)
+		{
+			known = static_cast<std::uint8_t>(current >> KNOWN_SHIFT);
+			if (epoch - builtEpoch >= REVALIDATE_FRAMES)
+			{
+				known &= flags;
+			}
+		}
+
+		const auto missing = static_cast<std::uint8_t>(a_flags & ~known);
+		if (!missing)
+		{
+			return static_cast<std::uint8_t>(flags & a_flags);
+		}
+
+		const auto built = Build(a_actor, missing);
+
+		// missing flags carried into a newer frame would live longer than REVALIDATE_FRAMES
+		const auto kept = static_cast<std::uint8_t>(builtEpoch == epoch ? known : known & flags);
+
+		// events can arrive before the change is fully applied, what was read during that frame is kept for that frame only
+		const auto settling = epoch == settleEpoch.load(std::memory_order_relaxed) || (kept && (current & SETTLING));
+
+		const auto desired = (static_cast<std::uint64_t>(epoch) << 32) |
+		                     (current & GENERATION_MASK) |
+		                     (settling ? SETTLING : 0) |
+		                     (static_cast<std::uint64_t>(kept | missing) << KNOWN_SHIFT) |
+		                     ((flags & kept) | built);
+
+		// an event that arrived while building bumped the generation and takes precedence
+		state.compare_exchange_strong(current, desired, std::memory_order_release, std::memory_order_relaxed);
+
+		return static_cast<std::uint8_t>(((flags & known) | built) & a_flags);
+	}
+
+	void Eligibility::Invalidate() noexcept
+	{
+		settleEpoch.store(Hooks::GetFrameEpoch(), std::memory_order_relaxed);
+
+		auto current = state.load(std::memory_order_relaxed);
+		while (!state.compare_exchange_weak(current, (current + GENERATION_ONE) & GENERATION_MASK, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	std::uint8_t Eligibility::Build(RE::Actor* a_actor, std::uint8_t a_flags)
+	{
+		std::uint8_t result = 0;
+
+		if ((a_flags & kHas3D) && a_actor->Is3DLoaded())
+		{
+			result |= kHas3D;
+		}
+
+		if (!(a_flags & kHasPlacement))
+		{
+			return result;
+		}
+
+		if (!g_interfaceIED)
+		{
+			return result | kHasPlacement;
+		}
+
+		// IED answers a single gear node per call, stop at the first placement
+		for (std::uint32_t i = 0; i < PlacementCache::GEAR_NODE_COUNT; i++)
+		{
+			if (g_interfaceIED->GetPlacementHintForGearNode(a_actor, static_cast<GearNodeID>(i)) != WeaponPlacementID::None)
+			{
+				return result | kHasPlacement;
+			}
+		}
+
+		return result;
+	}
+
+	void Entry::Invalidate() noexcept
+	{
+		shieldOnBack.Invalidate();
+		equipment.Invalidate();
+		eligibility.Invalidate();
+	}
+
+	void Entry::Reset() noexcept
+	{
+		equipment.ResetWornShield();
+		Invalidate();
+	}
+
+	Entry& Get(RE::TESObjectREFR* a_refr)
+	{
+		const auto formID = a_refr->GetFormID();
+		if (formID == PLAYER_FORM_ID)
+		{
+			return s_playerEntry;
+		}
+
+		{
+			const std::shared_lock lock(s_lock);
+
+			if (const auto it = s_entries.find(formID); it != s_entries.end())
+			{
+				return *it->second;
+			}
+		}
+
+		const std::unique_lock lock(s_lock);
+
+		auto& entry = s_entries[formID];
+		if (!entry)
+		{
+			entry = std::make_unique<Entry>();
+		}
+
+		return *entry;
+	}
+
+	Entry& GetPlayer() noexcept
+	{
+		return s_playerEntry;
+	}
+
+	void Invalidate(RE::FormID a_formID)
+	{
+		if (a_formID == PLAYER_FORM_ID)
+		{
+			s_playerEntry.Invalidate();
+			return;
+		}
+
+		const std::shared_lock lock(s_lock);
+
+		if (const auto it = s_entries.find(a_formID); it != s_entries.end())
+		{
+			it->second->Invalidate();
+		}
+	}
+
+	void InvalidateAll()
+	{
+		s_playerEntry.Reset();
+
+		const std::shared_lock lock(s_lock);
+
+		for (auto& e : s_entries)
+		{
+			e.second->Reset();
+		}
+	}
+
+	void SetWornShield(RE::Actor* a_actor, bool a_worn)
+	{
+		Get(a_actor).equipment.SetWornShield(a_worn);
+	}
+
+	bool IsEligible(RE::TESObjectREFR* a_refr, std::uint8_t a_flags)
+	{
+		if (!a_refr)
+		{
+			return true;
+		}
+
+		const auto actor = a_refr->As<RE::Actor>();
+
+		return actor && Get(actor).eligibility.Get(actor, a_flags) == a_flags;
+	}
+
+	WeaponPlacementID GetPlacementHintForGearNode(RE::TESObjectREFR* a_refr, GearNodeID a_id)
+	{
+		if (!a_refr)
+		{
+			return g_interfaceIED->GetPlacementHintForGearNode(a_refr, a_id);
+		}
+
+		const auto actor = a_refr->As<RE::Actor>();
+		if (!actor)
+		{
+			return WeaponPlacementID::None;
+		}
+
+		auto& entry = Get(actor);
+		if (!entry.eligibility.Get(actor, Eligibility::kHasPlacement))
+		{
+			return WeaponPlacementID::None;
+		}
+
+		return entry.placements.GetForGearNode(actor, a_id);
+	}
+
+	void GetPlacementHintsForGearNodes(RE::TESObjectREFR* a_refr, std::uint32_t a_mask, PlacementCache::GearNodePlacements& a_out)
+	{
+		if (!a_refr)
+		{
+			for (auto bits = a_mask & PlacementCache::GEAR_NODE_MASK; bits; bits &= bits - 1)
+			{
+				const auto slot = static_cast<std::uint32_t>(std::countr_zero(bits));
+				a_out[slot]     = g_interfaceIED->GetPlacementHintForGearNode(a_refr, static_cast<GearNodeID>(slot));
+			}
+
+			return;
+		}
+
+		const auto actor = a_refr->As<RE::Actor>();
+		auto       entry = actor ? std::addressof(Get(actor)) : nullptr;
+
+		if (!entry || !entry->eligibility.Get(actor, Eligibility::kHasPlacement))
+		{
+			a_out.fill(WeaponPlacementID::None);
+			return;
+		}
+
+		entry->placements.GetForGearNodes(actor, a_mask, a_out);
+	}
+
+	WeaponPlacementID GetPlacementHintForEquippedWeapon(RE::TESObjectREFR* a_refr, bool a_leftHand)
+	{
+		if (!a_refr)
+		{
+			return g_interfaceIED->GetPlacementHintForEquippedWeapon(a_refr, a_leftHand);
+		}
+
+		const auto actor = a_refr->As<RE::Actor>();
+		if (!actor)
+		{
+			return WeaponPlacementID::None;
+		}
+
+		auto& entry = Get(actor);
+		if (!entry.eligibility.Get(actor, Eligibility::kHasPlacement))
+		{
+			return WeaponPlacementID::None;
+		}
+
+		return entry.placements.GetForEquippedWeapon(actor, a_leftHand);
+	}
+
+	bool GetShieldOnBackEnabled(RE::Actor* a_actor)
+	{
+		return Get(a_actor).shieldOnBack.Get(a_actor);
+	}
+
+	EquipmentSnapshot::Hand GetEquippedHand(RE::TESObjectREFR* a_refr, bool a_leftHand)
+	{
+		const auto actor = a_refr ? a_refr->As<RE::Actor>() : nullptr;
+		if (!actor)
+		{
+			return {};
+		}
+
+		return Get(actor).equipment.Get(actor, a_leftHand);
+	}
+}
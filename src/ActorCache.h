@@ -0,0 +1,188 @@
+#pragma once
+
+namespace ActorCache
+{
+	using GearNodeID        = PluginInterfaceIED::GearNodeID;
+	using WeaponPlacementID = PluginInterfaceIED::WeaponPlacementID;
+
+	// placement hints of every gear node and both equipped weapons, filled on demand and valid for a single frame
+	// readers never block, a slot that is missing or stale is fetched from IED and published with the current frame epoch
+	// slots carry the low byte of the epoch they were fetched in, so a value stored by a writer that fell behind a frame
+	// advance reads as stale instead of being served under the newer epoch
+	class alignas(64) PlacementCache
+	{
+	public:
+		static constexpr std::uint32_t GEAR_NODE_COUNT = stl::to_underlying(GearNodeID::kTwoHandedAxeMaceLeft) + 1;
+
+		// bit n of a gear node mask selects GearNodeID n
+		static constexpr std::uint32_t GEAR_NODE_MASK = ((std::uint32_t(1) << GEAR_NODE_COUNT) - 1) & ~std::uint32_t(1);
+
+		using GearNodePlacements = std::array<WeaponPlacementID, GEAR_NODE_COUNT>;
+
+		[[nodiscard]] WeaponPlacementID GetForGearNode(RE::TESObjectREFR* a_refr, GearNodeID a_id);
+		[[nodiscard]] WeaponPlacementID GetForEquippedWeapon(RE::TESObjectREFR* a_refr, bool a_leftHand);
+
+		// fills the entries of a_out selected by a_mask, stale slots are fetched and published together
+		void GetForGearNodes(RE::TESObjectREFR* a_refr, std::uint32_t a_mask, GearNodePlacements& a_out);
+
+	private:
+		static constexpr std::uint32_t SLOT_EQUIPPED_RIGHT = GEAR_NODE_COUNT;
+		static constexpr std::uint32_t SLOT_EQUIPPED_LEFT  = GEAR_NODE_COUNT + 1;
+		static constexpr std::uint32_t SLOT_COUNT          = GEAR_NODE_COUNT + 2;
+
+		template <class Tf>
+		WeaponPlacementID Get(std::uint32_t a_slot, Tf a_fetch);
+
+		// false if the slot holds no value for a_epoch
+		bool Load(std::uint32_t a_slot, std::uint32_t a_epoch, WeaponPlacementID& a_out) const noexcept;
+		void Store(std::uint32_t a_slot, std::uint32_t a_epoch, WeaponPlacementID a_value) noexcept;
+
+		// dropped if a newer epoch was published since a_current was read
+		void Publish(std::uint32_t a_epoch, std::uint64_t a_bits, std::uint64_t a_current);
+
+		std::atomic<std::uint64_t>                         state{ 0 };  // frame epoch << 32 | mask of valid slots
+		std::array<std::atomic<std::uint16_t>, SLOT_COUNT> placements{};  // low byte of the frame epoch << 8 | WeaponPlacementID
+	};
+
+	static_assert(sizeof(PlacementCache) == 64);
+
+	// SDS shield-on-back state, fetched once and then kept current by events
+	class ShieldOnBackState
+	{
+	public:
+		[[nodiscard]] bool Get(RE::Actor* a_actor);
+		void               Set(bool a_value) noexcept;
+		void               Invalidate() noexcept;
+
+	private:
+		static constexpr std::uint32_t UNKNOWN        = 0xFF;
+		static constexpr std::uint32_t VALUE_MASK     = 0xFF;
+		static constexpr std::uint32_t GENERATION_ONE = 1u << 8;
+
+		// stores a_value under a new generation, so a fetch that started before can't replace it
+		void Replace(std::uint32_t a_value) noexcept;
+
+		std::atomic<std::uint32_t> state{ UNKNOWN };  // generation << 8 | 0, 1 or UNKNOWN
+		std::atomic<std::uint32_t> settleEpoch{ 0 };  // the actor may still be changing until this frame has passed
+	};
+
+	// what the actor holds in each hand, rebuilt on first use after an equip or load event
+	class EquipmentSnapshot
+	{
+	public:
+		// bits of Hand::traits, kept below bit 24 so any mask survives the float of a numeric condition component
+		enum Trait : std::uint32_t
+		{
+			kTraitEquipped     = 1u << 0,
+			kTraitWeapon       = 1u << 1,
+			kTraitBound        = 1u << 2,
+			kTraitOneHanded    = 1u << 3,  // swords, daggers, axes, maces and staves
+			kTraitTwoHanded    = 1u << 4,  // greatswords, battleaxes, warhammers, bows and crossbows
+			kTraitRanged       = 1u << 5,
+			kTraitHasEquipSlot = 1u << 6,
+			kTraitShield       = 1u << 7,
+
+			kTraitWeaponTypeShift = 8  // bit 8 + RE::WEAPON_TYPE is set for weapons
+		};
+
+		struct Hand
+		{
+			RE::TESForm*      object{ nullptr };
+			RE::BGSEquipSlot* equipSlot{ nullptr };
+			RE::WEAPON_TYPE   weaponType{ RE::WEAPON_TYPE::kHandToHandMelee };
+			std::uint32_t     traits{ 0 };
+			bool              isWeapon{ false };
+			bool              isBound{ false };
+		};
+
+		[[nodiscard]] Hand Get(RE::Actor* a_actor, bool a_leftHand);
+		void               Invalidate() noexcept;
+
+		// worn armor is only safe to read on the main thread, so equip and load events record the shield there
+		// before the first event the actor's worn armor is read without initializing its inventory
+		void SetWornShield(bool a_worn) noexcept;
+		void ResetWornShield() noexcept;
+
+	private:
+		static constexpr std::int8_t UNKNOWN = -1;
+
+		[[nodiscard]] Hand MakeHand(RE::Actor* a_actor, bool a_leftHand) const;
+		[[nodiscard]] bool IsShieldWorn(RE::Actor* a_actor) const;
+
+		std::shared_mutex          lock;
+		std::array<Hand, 2>        hands;                  // right, left
+		std::atomic<std::uint32_t> generation{ 1 };        // bumped by Invalidate
+		std::uint32_t              builtGeneration{ 0 };   // generation the hands were built for
+		std::atomic<std::uint32_t> settleEpoch{ 0 };       // equipment may still be changing until this frame has passed
+		std::atomic<std::int8_t>   wornShield{ UNKNOWN };  // kept across Invalidate, the event that records it also invalidates
+	};
+
+	// flags that let conditions skip actors which can't match before calling into IED
+	// each flag is built on first use and dropped by load, unload and equip events, a missing flag is also rebuilt
+	// after a few frames since 3D and IED state can appear without an event
+	class Eligibility
+	{
+	public:
+		enum Flag : std::uint8_t
+		{
+			kHas3D        = 1 << 0,
+			kHasPlacement = 1 << 1,  // IED reports a placement other than None for at least one gear node
+
+			kAll = kHas3D | kHasPlacement
+		};
+
+		// the flags of a_flags the actor has, only those that aren't known yet are built
+		[[nodiscard]] std::uint8_t Get(RE::Actor* a_actor, std::uint8_t a_flags);
+		void                       Invalidate() noexcept;
+
+	private:
+		static constexpr std::uint32_t REVALIDATE_FRAMES = 4;
+
+		// state: frame epoch << 32 | generation << 24 | SETTLING | known flags << 8 | flags
+		static constexpr std::uint64_t KNOWN_SHIFT     = 8;
+		static constexpr std::uint64_t SETTLING        = std::uint64_t(1) << 16;  // read in an event frame, valid for that frame only
+		static constexpr std::uint64_t GENERATION_ONE  = std::uint64_t(1) << 24;
+		static constexpr std::uint64_t GENERATION_MASK = std::uint64_t(0xFF) << 24;
+
+		static std::uint8_t Build(RE::Actor* a_actor, std::uint8_t a_flags);
+
+		std::atomic<std::uint64_t> state{ 0 };
+		std::atomic<std::uint32_t> settleEpoch{ 0 };  // 3D and equipment may still be changing until this frame has passed
+	};
+
+	struct Entry
+	{
+		void Invalidate() noexcept;
+
+		// also forgets what events recorded, for a game load
+		void Reset() noexcept;
+
+		PlacementCache    placements;
+		ShieldOnBackState shieldOnBack;
+		EquipmentSnapshot equipment;
+		Eligibility       eligibility;
+	};
+
+	// entries are created on first use and never removed so references stay valid
+	[[nodiscard]] Entry& Get(RE::TESObjectREFR* a_refr);
+	[[nodiscard]] Entry& GetPlayer() noexcept;
+
+	// drops event-driven state of a single ref (equip, load) or of every ref (game load)
+	void Invalidate(RE::FormID a_formID);
+	void InvalidateAll();
+
+	// called from equip and load events on the main thread
+	void SetWornShield(RE::Actor* a_actor, bool a_worn);
+
+	// false for refs that are not actors or lack one of a_flags, true for a null ref (unknown)
+	[[nodiscard]] bool IsEligible(RE::TESObjectREFR* a_refr, std::uint8_t a_flags);
+
+	// non-actors and actors without any placement read as WeaponPlacementID::None without calling IED
+	[[nodiscard]] WeaponPlacementID GetPlacementHintForGearNode(RE::TESObjectREFR* a_refr, GearNodeID a_id);
+	void                            GetPlacementHintsForGearNodes(RE::TESObjectREFR* a_refr, std::uint32_t a_mask, PlacementCache::GearNodePlacements& a_out);
+	[[nodiscard]] WeaponPlacementID GetPlacementHintForEquippedWeapon(RE::TESObjectREFR* a_refr, bool a_leftHand);
+	[[nodiscard]] bool              GetShieldOnBackEnabled(RE::Actor* a_actor);
+
+	// empty if a_refr is not an actor
+	[[nodiscard]] EquipmentSnapshot::Hand GetEquippedHand(RE::TESObjectREFR* a_refr, bool a_leftHand);
+}
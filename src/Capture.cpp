@@ -0,0 +1,339 @@
+#include "Capture.h"
+
+#include <fstream>
+
+#include "Config.h"
+#include "Profiling.h"
+#include "StringHelpers.h"
+
+namespace Capture
+{
+	namespace
+	{
+		struct Pending
+		{
+			std::int32_t  arguments[MAX_VALUES];
+			std::int32_t  responses[MAX_VALUES];
+			std::uint32_t argumentCount{ 0 };
+			std::uint32_t responseCount{ 0 };
+			Source        source{ Source::kEvaluated };
+		};
+
+		std::atomic<bool>          s_active{ false };
+		std::atomic<std::uint32_t> s_writers{ 0 };
+
+		// set while active, only released by Update once s_active is cleared and no writer is left
+		FileHeader* s_header{ nullptr };
+		Record*     s_records{ nullptr };
+
+		// main thread only
+		HANDLE                                s_file{ INVALID_HANDLE_VALUE };
+		HANDLE                                s_mapping{ nullptr };
+		std::chrono::steady_clock::time_point s_startTime;
+		std::filesystem::path                 s_path;
+
+		thread_local Pending* t_pending = nullptr;
+
+		// texts of the hashed arguments and names, cleared by Start and written out by Update
+		std::shared_mutex                              s_stringsLock;
+		std::unordered_map<std::uint32_t, std::string> s_strings;
+		std::atomic<std::uint32_t>                     s_missingStrings{ 0 };  // texts that couldn't be stored
+
+		// texts that differ in more than case but share a hash take the next free value, so every value names one text
+		// called from the noexcept record writers, a text that can't be stored is still recorded by value and missing
+		// from the strings file, replay skips such records
+		std::int32_t Intern(std::string_view a_text) noexcept
+		{
+			auto hash = static_cast<std::uint32_t>(StringHelpers::ihash(a_text));
+
+			try
+			{
+				{
+					const std::shared_lock lock(s_stringsLock);
+
+					for (;; hash++)
+					{
+						const auto it = s_strings.find(hash);
+						if (it == s_strings.end())
+						{
+							break;
+						}
+
+						if (StringHelpers::iequals(it->second, a_text))
+						{
+							return static_cast<std::int32_t>(hash);
+						}
+					}
+				}
+
+				// another thread may have stored the text or taken the value since the shared lock was released
+				const std::unique_lock lock(s_stringsLock);
+
+				for (;; hash++)
+				{
+					const auto [it, inserted] = s_strings.try_emplace(hash, a_text);
+					if (inserted || StringHelpers::iequals(it->second, a_text))
+					{
+						return static_cast<std::int32_t>(hash);
+					}
+				}
+			}
+			catch (const std::bad_alloc&)
+			{
+				s_missingStrings.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			return static_cast<std::int32_t>(hash);
+		}
+
+		void WriteStrings()
+		{
+			const auto path = GetStringsPath(s_path);
+
+			std::ofstream file(path, std::ios::trunc);
+			if (!file)
+			{
+				logs::error("Failed to write {}"sv, path.string());
+				return;
+			}
+
+			const std::shared_lock lock(s_stringsLock);
+
+			for (const auto& [hash, text] : s_strings)
+			{
+				file << std::format("{:08X}\t{}\n", hash, text);
+			}
+
+			if (const auto missing = s_missingStrings.load(std::memory_order_relaxed))
+			{
+				logs::warn("{} texts ran out of memory and are missing from {}"sv, missing, path.string());
+			}
+		}
+
+		void Release()
+		{
+			if (s_header)
+			{
+				UnmapViewOfFile(s_header);
+				s_header  = nullptr;
+				s_records = nullptr;
+			}
+
+			if (s_mapping)
+			{
+				CloseHandle(s_mapping);
+				s_mapping = nullptr;
+			}
+
+			if (s_file != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(s_file);
+				s_file = INVALID_HANDLE_VALUE;
+			}
+		}
+	}
+
+	void Start()
+	{
+		if (s_active.load() || s_header)
+		{
+			return;
+		}
+
+		auto path = logs::log_directory();
+		if (!path)
+		{
+			return;
+		}
+
+		const auto plugin = SKSE::PluginDeclaration::GetSingleton();
+		*path /= std::format("{}_capture.bin", plugin->GetName());
+
+		const auto capacity = std::max<std::uint64_t>(Config::captureRecords, 1);
+		const auto size     = sizeof(FileHeader) + capacity * sizeof(Record);
+
+		s_file = CreateFileW(path->c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (s_file != INVALID_HANDLE_VALUE)
+		{
+			s_mapping = CreateFileMappingW(s_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+		}
+
+		const auto view = s_mapping ? MapViewOfFile(s_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size) : nullptr;
+		if (!view)
+		{
+			logs::error("Failed to map {} ({} bytes)"sv, path->string(), size);
+			Release();
+			return;
+		}
+
+		// a fresh mapping is zero filled, so every record starts out incomplete
+		s_header  = static_cast<FileHeader*>(view);
+		s_records = reinterpret_cast<Record*>(s_header + 1);
+
+		std::memcpy(s_header->magic, "OARIEDCP", sizeof(s_header->magic));
+		s_header->version     = FILE_VERSION;
+		s_header->recordSize  = sizeof(Record);
+		s_header->capacity    = capacity;
+		s_header->startCycles = Profiling::ReadCycleCounter();
+
+		s_startTime = std::chrono::steady_clock::now();
+		s_path      = std::move(*path);
+
+		{
+			const std::unique_lock lock(s_stringsLock);
+			s_strings.clear();
+		}
+
+		s_missingStrings.store(0, std::memory_order_relaxed);
+
+		s_active.store(true);
+
+		logs::info("Capture started, writing up to {} records to {}"sv, capacity, s_path.string());
+	}
+
+	void Stop()
+	{
+		if (!s_active.exchange(false))
+		{
+			return;
+		}
+
+		const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - s_startTime).count();
+		const auto cycles    = Profiling::ReadCycleCounter() - s_header->startCycles;
+
+		s_header->cyclesPerMs = elapsedMs > 0 ? cycles / static_cast<std::uint64_t>(elapsedMs) : 0;
+
+		logs::info("Capture stopped after {} records"sv, s_header->head.load());
+	}
+
+	void Toggle()
+	{
+		if (IsActive())
+		{
+			Stop();
+		}
+		else
+		{
+			Start();
+		}
+	}
+
+	bool IsActive() noexcept
+	{
+		return s_active.load(std::memory_order_relaxed);
+	}
+
+	void Update()
+	{
+		if (s_header && !s_active.load() && s_writers.load() == 0)
+		{
+			FlushViewOfFile(s_header, 0);
+			Release();
+			WriteStrings();
+
+			logs::info("Capture written to {}"sv, s_path.string());
+		}
+	}
+
+#if defined(ENABLE_PROFILING)
+	void Begin() noexcept
+	{
+		if (!s_active.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		static thread_local Pending pending;
+
+		pending.argumentCount = 0;
+		pending.responseCount = 0;
+		pending.source        = Source::kEvaluated;
+
+		t_pending = std::addressof(pending);
+	}
+
+	void End(Conditions::ConditionID a_id, RE::FormID a_formID, bool a_negated, bool a_result, std::uint64_t a_startCycles) noexcept
+	{
+		const auto pending = std::exchange(t_pending, nullptr);
+		if (!pending)
+		{
+			return;
+		}
+
+		// a stopped capture keeps its mapping until every writer that got past this check is done
+		s_writers.fetch_add(1);
+
+		if (s_active.load())
+		{
+			const auto index  = s_header->head.fetch_add(1, std::memory_order_relaxed);
+			auto&      record = s_records[index % s_header->capacity];
+
+			const auto argumentCount = std::min<std::uint32_t>(pending->argumentCount, MAX_VALUES);
+			const auto responseCount = std::min<std::uint32_t>(pending->responseCount, MAX_VALUES - argumentCount);
+
+			record.sequence.store(0, std::memory_order_relaxed);
+
+			record.cycles        = a_startCycles;
+			record.formID        = a_formID;
+			record.conditionID   = static_cast<std::uint8_t>(a_id);
+			record.result        = a_result;
+			record.argumentCount = static_cast<std::uint8_t>(argumentCount);
+			record.responseCount = static_cast<std::uint8_t>(responseCount);
+			record.source        = pending->source;
+			record.negated       = a_negated;
+
+			std::copy_n(pending->arguments, argumentCount, record.values);
+			std::copy_n(pending->responses, responseCount, record.values + argumentCount);
+
+			record.sequence.store(index + 1, std::memory_order_release);
+		}
+
+		s_writers.fetch_sub(1, std::memory_order_release);
+	}
+
+	bool IsRecording() noexcept
+	{
+		return t_pending != nullptr;
+	}
+
+	void SetSource(Source a_source) noexcept
+	{
+		if (const auto pending = t_pending)
+		{
+			pending->source = a_source;
+		}
+	}
+
+	void AddArgument(std::int32_t a_value) noexcept
+	{
+		if (const auto pending = t_pending; pending && pending->argumentCount < MAX_VALUES)
+		{
+			pending->arguments[pending->argumentCount++] = a_value;
+		}
+	}
+
+	void AddArgument(std::string_view a_text) noexcept
+	{
+		if (t_pending)
+		{
+			AddArgument(Intern(a_text));
+		}
+	}
+
+	void AddResponse(std::int32_t a_value) noexcept
+	{
+		if (const auto pending = t_pending; pending && pending->responseCount < MAX_VALUES)
+		{
+			pending->responses[pending->responseCount++] = a_value;
+		}
+	}
+
+	void AddResponse(std::string_view a_name) noexcept
+	{
+		if (t_pending)
+		{
+			AddResponse(Intern(a_name));
+		}
+	}
+#endif
+}
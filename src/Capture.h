@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ConditionID.h"
+
+// capture of every condition evaluation into a memory-mapped ring file in the log directory, profiling builds only
+//
+// file layout: a 64 byte FileHeader followed by FileHeader::capacity 64 byte Records
+// record n (counting from 0) is stored in slot n % capacity and is complete once its sequence equals n + 1,
+// the records still present are the ones numbered [max(head, capacity) - capacity, head)
+//
+// arguments are the values of every component except 'Cache (ms)' and 'Cache per clip' in component order, resolved for
+// the evaluated ref: numeric values truncated to integers, bools as 0 or 1, comparison operators, form IDs, and texts as
+// the low 32 bits of StringHelpers::ihash (the next free value if a different text already has it). names returned by
+// IED are hashed the same way, every hashed text is written to the strings file next to the capture (see
+// GetStringsPath) when the capture is released
+namespace Capture
+{
+	constexpr std::uint32_t FILE_VERSION = 2;
+	constexpr std::size_t   MAX_VALUES   = 9;
+
+	// how the result of a record was produced, only kEvaluated records carry responses
+	enum class Source : std::uint8_t
+	{
+		kEvaluated,
+		kShared,      // computed by another instance with the same arguments this frame
+		kTimedCache,  // 'Cache (ms)'
+		kClipCache,   // 'Cache per clip'
+		kDisabled
+	};
+
+	struct FileHeader
+	{
+		char                       magic[8];      // "OARIEDCP"
+		std::uint32_t              version;       // FILE_VERSION
+		std::uint32_t              recordSize;    // sizeof(Record)
+		std::uint64_t              capacity;      // records in the ring
+		std::atomic<std::uint64_t> head;          // records written so far
+		std::uint64_t              startCycles;   // cycle counter when the capture started
+		std::uint64_t              cyclesPerMs;   // measured over the capture, 0 until it stopped
+		std::uint8_t               pad[16];
+	};
+
+	static_assert(sizeof(FileHeader) == 64);
+
+	struct Record
+	{
+		std::atomic<std::uint64_t> sequence;       // record number + 1, written last
+		std::uint64_t              cycles;         // cycle counter at the start of the evaluation
+		RE::FormID                 formID;         // evaluated ref, 0 if none
+		std::uint8_t               conditionID;    // Conditions::ConditionID
+		std::uint8_t               result;         // after negation
+		std::uint8_t               argumentCount;  // stored first in values
+		std::uint8_t               responseCount;  // values returned by IED/SDS and the game, stored after the arguments
+		Source                     source;
+		std::uint8_t               negated;
+		std::uint8_t               pad[2];
+		std::int32_t               values[MAX_VALUES];
+	};
+
+	static_assert(sizeof(Record) == 64);
+
+	// one "hash<TAB>text" line per hashed text with the hash in hex, texts that only differ in case share a line
+	[[nodiscard]] inline std::filesystem::path GetStringsPath(const std::filesystem::path& a_capture)
+	{
+		return a_capture.parent_path() / (a_capture.stem().string() + "_strings.txt");
+	}
+
+	void Start();
+	void Stop();
+	void Toggle();
+
+	[[nodiscard]] bool IsActive() noexcept;
+
+	// called every frame, releases the file of a stopped capture once no evaluation writes to it
+	void Update();
+
+#if defined(ENABLE_PROFILING)
+	// brackets a single evaluation, the values added in between are attached to its record
+	void Begin() noexcept;
+	void End(Conditions::ConditionID a_id, RE::FormID a_formID, bool a_negated, bool a_result, std::uint64_t a_startCycles) noexcept;
+
+	// true between Begin and End while a capture is running
+	[[nodiscard]] bool IsRecording() noexcept;
+
+	void SetSource(Source a_source) noexcept;
+
+	void AddArgument(std::int32_t a_value) noexcept;
+	void AddArgument(std::string_view a_text) noexcept;
+	void AddResponse(std::int32_t a_value) noexcept;
+	void AddResponse(std::string_view a_name) noexcept;
+#else
+	inline void SetSource(Source) noexcept {}
+
+	inline void AddArgument(std::int32_t) noexcept {}
+	inline void AddArgument(std::string_view) noexcept {}
+	inline void AddResponse(std::int32_t) noexcept {}
+	inline void AddResponse(std::string_view) noexcept {}
+#endif
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace Conditions
+{
+	enum class ConditionID : std::uint32_t
+	{
+		kIEDNodePlacement,
+		kIEDNodesPlacement,
+		kIEDNodeEquippedPlacement,
+		kIEDNodeParentName,
+		kIEDNodeParentNameInList,
+		kIEDHasEquipmentSlot,
+		kIEDIsBoundWeaponEquipped,
+		kIEDEquippedWeaponTraits,
+		kIEDPluginOption,
+		kSDSShieldOnBackEnabled,
+		kSDSWeaponNodeSharingDisabled,
+
+		kTotal
+	};
+
+	[[nodiscard]] std::string_view GetConditionName(ConditionID a_id) noexcept;
+}
@@ -1,9 +1,450 @@
 #include "Conditions.h"
 
+#include "ActorCache.h"
+#include "Capture.h"
+#include "Hooks.h"
 #include "Interface.h"
+#include "Profiling.h"
+#include "SettingsSnapshot.h"
+#include "StringHelpers.h"
+#include "Trace.h"
 
 namespace Conditions
 {
+	namespace
+	{
+		// parent names of actors without 3D read as missing without calling IED
+		RE::BSString GetGearNodeParentName(RE::TESObjectREFR* a_refr, PluginInterfaceIED::GearNodeID a_id)
+		{
+			return ActorCache::IsEligible(a_refr, ActorCache::Eligibility::kHas3D) ? g_interfaceIED->GetGearNodeParentName(a_refr, a_id) : RE::BSString{};
+		}
+
+		// nested form lists are followed up to this depth, which also stops self-referencing lists
+		constexpr std::uint32_t MAX_FORM_LIST_DEPTH = 8;
+
+		void CollectFormIDs(RE::TESForm* a_form, std::vector<RE::FormID>& a_out, std::uint32_t a_depth = 0)
+		{
+			if (!a_form)
+			{
+				return;
+			}
+
+			const auto list = a_form->As<RE::BGSListForm>();
+			if (!list)
+			{
+				a_out.emplace_back(a_form->GetFormID());
+				return;
+			}
+
+			if (a_depth >= MAX_FORM_LIST_DEPTH)
+			{
+				return;
+			}
+
+			list->ForEachForm([&](RE::TESForm& a_entry) {
+				CollectFormIDs(std::addressof(a_entry), a_out, a_depth + 1);
+				return RE::BSContainer::ForEachResult::kContinue;
+			});
+		}
+
+		// a_form's ID, or the IDs in it when it is a form list, sorted and without duplicates
+		std::vector<RE::FormID> GetSortedFormIDs(RE::TESForm* a_form)
+		{
+			std::vector<RE::FormID> result;
+			CollectFormIDs(a_form, result);
+
+			std::ranges::sort(result);
+			const auto [first, last] = std::ranges::unique(result);
+			result.erase(first, last);
+			result.shrink_to_fit();
+
+			return result;
+		}
+	}
+
+	std::string_view GetConditionName(ConditionID a_id) noexcept
+	{
+		switch (a_id)
+		{
+		case ConditionID::kIEDNodePlacement:
+			return IEDNodePlacementCondition::CONDITION_NAME;
+		case ConditionID::kIEDNodesPlacement:
+			return IEDNodesPlacementCondition::CONDITION_NAME;
+		case ConditionID::kIEDNodeEquippedPlacement:
+			return IEDNodeEquippedPlacementCondition::CONDITION_NAME;
+		case ConditionID::kIEDNodeParentName:
+			return IEDNodeParentNameCondition::CONDITION_NAME;
+		case ConditionID::kIEDNodeParentNameInList:
+			return IEDNodeParentNameInListCondition::CONDITION_NAME;
+		case ConditionID::kIEDHasEquipmentSlot:
+			return IEDHasEquipmentSlot::CONDITION_NAME;
+		case ConditionID::kIEDIsBoundWeaponEquipped:
+			return IEDIsBoundWeaponEquipped::CONDITION_NAME;
+		case ConditionID::kIEDEquippedWeaponTraits:
+			return IEDEquippedWeaponTraitsCondition::CONDITION_NAME;
+		case ConditionID::kIEDPluginOption:
+			return IEDPluginOptionCondition::CONDITION_NAME;
+		case ConditionID::kSDSShieldOnBackEnabled:
+			return SDSShieldOnBackEnabledCondition::CONDITION_NAME;
+		case ConditionID::kSDSWeaponNodeSharingDisabled:
+			return SDSWeaponNodeSharingDisabledCondition::CONDITION_NAME;
+		default:
+			return "Unknown"sv;
+		}
+	}
+
+	void IntegerComparison::Resolve(const IComparisonConditionComponent* a_component)
+	{
+		switch (a_component->GetComparisonOperator())
+		{
+		case ComparisonOperator::kEqual:
+			func = Compare<std::equal_to<>>;
+			break;
+		case ComparisonOperator::kNotEqual:
+			func = Compare<std::not_equal_to<>>;
+			break;
+		case ComparisonOperator::kGreater:
+			func = Compare<std::greater<>>;
+			break;
+		case ComparisonOperator::kGreaterEqual:
+			func = Compare<std::greater_equal<>>;
+			break;
+		case ComparisonOperator::kLess:
+			func = Compare<std::less<>>;
+			break;
+		case ComparisonOperator::kLessEqual:
+			func = Compare<std::less_equal<>>;
+			break;
+		default:
+			func = Never;
+			break;
+		}
+	}
+
+	RE::BSString ConditionBase::GetArgument() const
+	{
+		const std::lock_guard lock(argumentLock);
+
+		if (!argumentValid)
+		{
+			ArgumentBuffer buffer;
+			FormatArgument(buffer);
+
+			argument      = buffer.c_str();
+			argumentValid = true;
+		}
+
+		return argument;
+	}
+
+	ConditionBase::~ConditionBase()
+	{
+		if (clipCacheUser)
+		{
+			Hooks::RemoveClipCacheUser();
+		}
+	}
+
+	bool ConditionBase::Evaluate(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const
+	{
+		const auto& current = GetState();
+
+#if defined(ENABLE_PROFILING)
+		Capture::Begin();
+
+		const auto start  = Profiling::ReadCycleCounter();
+		const auto result = EvaluateWithClipCache(current, a_refr, a_clipGenerator);
+		const auto end    = Profiling::ReadCycleCounter();
+
+		const auto formID = a_refr ? a_refr->GetFormID() : 0;
+
+		// recorded after the evaluation so values read from globals are seen on every path, cached or not
+		if (Capture::IsRecording())
+		{
+			CaptureArguments(a_refr);
+		}
+
+		Profiling::Record(GetID(), result, end - start);
+		Trace::Record(GetID(), formID, result, start, end);
+		Capture::End(GetID(), formID, IsNegated(), result, start);
+
+		return result;
+#else
+		return EvaluateWithClipCache(current, a_refr, a_clipGenerator);
+#endif
+	}
+
+	bool ConditionBase::EvaluateImpl(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const
+	{
+		return EvaluateResolved(GetState(), a_refr, a_clipGenerator);
+	}
+
+	bool ConditionBase::EvaluateWithClipCache(const State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const
+	{
+		if (!a_state.useClipCache || !a_clipGenerator)
+		{
+			return EvaluateWithTimedCache(a_state, a_refr, a_clipGenerator);
+		}
+
+		const auto activation = Hooks::GetClipActivation(a_clipGenerator);
+		if (!activation)
+		{
+			return EvaluateWithTimedCache(a_state, a_refr, a_clipGenerator);
+		}
+
+		const auto formID = a_refr ? a_refr->GetFormID() : 0;
+
+		{
+			const std::shared_lock lock(clipResultsLock);
+
+			if (const auto it = clipResults.find(a_clipGenerator); it != clipResults.end())
+			{
+				if (it->second.state == std::addressof(a_state) && it->second.activation == activation && it->second.formID == formID)
+				{
+					Capture::SetSource(Capture::Source::kClipCache);
+					return it->second.result;
+				}
+			}
+		}
+
+		const auto result = EvaluateWithTimedCache(a_state, a_refr, a_clipGenerator);
+
+		const std::unique_lock lock(clipResultsLock);
+
+		if (clipResults.size() >= MAX_CLIP_RESULTS)
+		{
+			clipResults.clear();
+		}
+
+		clipResults.insert_or_assign(a_clipGenerator, ClipResult{ std::addressof(a_state), activation, formID, result });
+
+		return result;
+	}
+
+	bool ConditionBase::EvaluateWithTimedCache(const State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const
+	{
+		const auto cacheTime = a_state.cacheTime;
+		if (!cacheTime || !a_refr)
+		{
+			return EvaluateWithSharedResults(a_state, a_refr, a_clipGenerator);
+		}
+
+		const auto now    = RE::GetDurationOfApplicationRunTime();
+		const auto formID = a_refr->GetFormID();
+
+		{
+			const std::shared_lock lock(timedResultsLock);
+
+			if (const auto it = timedResults.find(formID); it != timedResults.end() && it->second.state == std::addressof(a_state) && now - it->second.time < cacheTime)
+			{
+				Capture::SetSource(Capture::Source::kTimedCache);
+				return it->second.result;
+			}
+		}
+
+		const auto result = EvaluateWithSharedResults(a_state, a_refr, a_clipGenerator);
+
+		const std::unique_lock lock(timedResultsLock);
+
+		if (timedResults.size() >= MAX_TIMED_RESULTS)
+		{
+			std::erase_if(timedResults, [&](const auto& a_entry) {
+				return now - a_entry.second.time >= cacheTime;
+			});
+		}
+
+		timedResults.insert_or_assign(formID, TimedResult{ std::addressof(a_state), now, result });
+
+		return result;
+	}
+
+	bool ConditionBase::EvaluateWithSharedResults(const State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const
+	{
+		if (IsDisabled())
+		{
+			Capture::SetSource(Capture::Source::kDisabled);
+			return true;
+		}
+
+		const auto shared = a_state.sharedResults.get();
+		if (!shared || !a_refr)
+		{
+			const auto result = EvaluateResolved(a_state, a_refr, a_clipGenerator);
+			return IsNegated() ? !result : result;
+		}
+
+		const auto formID = a_refr->GetFormID();
+
+		auto result = shared->Get(formID);
+		if (result)
+		{
+			Capture::SetSource(Capture::Source::kShared);
+		}
+		else
+		{
+			result = EvaluateResolved(a_state, a_refr, a_clipGenerator);
+			shared->Set(formID, *result);
+		}
+
+		return IsNegated() ? !*result : *result;
+	}
+
+	void ConditionBase::ShareResults(State& a_state, std::initializer_list<std::uint64_t> a_arguments) const
+	{
+		SharedResults::Key key;
+		key.reserve(a_arguments.size() + 1);
+
+		key.emplace_back(stl::to_underlying(GetID()));
+		key.insert(key.end(), a_arguments);
+
+		a_state.sharedResults = SharedResults::Acquire(std::move(key));
+	}
+
+	void ConditionBase::ClearCachedResults() const
+	{
+		{
+			const std::unique_lock lock(clipResultsLock);
+			clipResults.clear();
+		}
+
+		const std::unique_lock lock(timedResultsLock);
+		timedResults.clear();
+	}
+
+	void ConditionBase::CaptureArguments(RE::TESObjectREFR* a_refr) const
+	{
+		for (std::uint32_t i = 0; i < GetNumComponents(); i++)
+		{
+			const auto component = GetComponent(i);
+			if (component == cacheTimeComponent || component == clipCacheComponent)
+			{
+				continue;
+			}
+
+			switch (component->GetType())
+			{
+			case ConditionComponentType::kNumeric:
+				Capture::AddArgument(static_cast<std::int32_t>(static_cast<INumericConditionComponent*>(component)->GetNumericValue(a_refr)));
+				break;
+			case ConditionComponentType::kBool:
+				Capture::AddArgument(static_cast<IBoolConditionComponent*>(component)->GetBoolValue());
+				break;
+			case ConditionComponentType::kComparison:
+				Capture::AddArgument(stl::to_underlying(static_cast<IComparisonConditionComponent*>(component)->GetComparisonOperator()));
+				break;
+			case ConditionComponentType::kText:
+				Capture::AddArgument(static_cast<ITextConditionComponent*>(component)->GetTextValue().c_str());
+				break;
+			case ConditionComponentType::kForm:
+				{
+					const auto form = static_cast<IFormConditionComponent*>(component)->GetTESFormValue();
+					Capture::AddArgument(static_cast<std::int32_t>(form ? form->GetFormID() : 0));
+				}
+				break;
+			default:
+				Capture::AddArgument(0);
+				break;
+			}
+		}
+	}
+
+	void ConditionBase::AddCacheTimeComponent()
+	{
+		cacheTimeComponent = static_cast<INumericConditionComponent*>(AddBaseComponent(
+			ConditionComponentType::kNumeric,
+			"Cache (ms)",
+			"Reuse the result for the same ref until this many milliseconds have passed, 0 evaluates every time."));
+	}
+
+	void ConditionBase::AddClipCacheComponent()
+	{
+		clipCacheComponent = static_cast<IBoolConditionComponent*>(AddBaseComponent(
+			ConditionComponentType::kBool,
+			"Cache per clip",
+			"Evaluate once when the clip is activated and reuse the result until it is activated again."));
+	}
+
+	std::unique_ptr<ConditionBase::State> ConditionBase::Resolve() const
+	{
+		auto result = ResolveComponents();
+
+		const auto time = cacheTimeComponent ? cacheTimeComponent->GetNumericValue(nullptr) : 0.0f;
+
+		result->cacheTime    = time > 0.0f ? static_cast<std::uint32_t>(time) : 0;
+		result->useClipCache = clipCacheComponent && clipCacheComponent->GetBoolValue();
+
+		return result;
+	}
+
+	const ConditionBase::State& ConditionBase::GetState() const
+	{
+		if (const auto current = state.load(std::memory_order_acquire))
+		{
+			return *current;
+		}
+
+		// evaluated before PostInitialize ran
+		const std::lock_guard lock(stateLock);
+
+		if (const auto current = state.load(std::memory_order_relaxed))
+		{
+			return *current;
+		}
+
+		return Publish(Resolve());
+	}
+
+	const ConditionBase::State& ConditionBase::Publish(std::unique_ptr<State> a_state) const
+	{
+		if (a_state->useClipCache != clipCacheUser)
+		{
+			clipCacheUser = a_state->useClipCache;
+
+			if (clipCacheUser)
+			{
+				Hooks::AddClipCacheUser();
+			}
+			else
+			{
+				Hooks::RemoveClipCacheUser();
+			}
+		}
+
+		const auto& result = states.emplace_back(std::move(a_state));
+		state.store(result.get(), std::memory_order_release);
+
+		return *result;
+	}
+
+	void ConditionBase::SetDisabled(bool a_disabled)
+	{
+		CustomCondition::SetDisabled(a_disabled);
+		ClearCachedResults();
+	}
+
+	void ConditionBase::SetNegated(bool a_negated)
+	{
+		CustomCondition::SetNegated(a_negated);
+		ClearCachedResults();
+	}
+
+	void ConditionBase::PostInitialize()
+	{
+		CustomCondition::PostInitialize();
+
+		auto resolved = Resolve();
+
+		{
+			const std::lock_guard lock(stateLock);
+			Publish(std::move(resolved));
+		}
+
+		ClearCachedResults();
+
+		const std::lock_guard lock(argumentLock);
+		argumentValid = false;
+	}
+
 	IEDNodePlacementCondition::IEDNodePlacementCondition()
 	{
 		gearNodeIDComponent        = static_cast<INumericConditionComponent*>(AddBaseComponent(
@@ -15,20 +456,22 @@ namespace Conditions
 		weaponPlacementIDComponent = static_cast<INumericConditionComponent*>(AddBaseComponent(
 			ConditionComponentType::kNumeric,
 			"Weapon placement ID"));
+
+		AddCacheTimeComponent();
+		AddClipCacheComponent();
 	}
 
-	RE::BSString IEDNodePlacementCondition::GetArgument() const
+	void IEDNodePlacementCondition::FormatArgument(ArgumentBuffer& a_out) const
 	{
 		const auto gearNodeIdArgument        = gearNodeIDComponent->GetArgument();
 		const auto comparisonArgument        = comparisonComponent->GetArgument();
 		const auto weaponPlacementIdArgument = weaponPlacementIDComponent->GetArgument();
 
-		return std::format(
-				   "GetPlacementHintForGearNode({}) {} {}",
-				   gearNodeIdArgument.data(),
-				   comparisonArgument.data(),
-				   weaponPlacementIdArgument.data())
-		    .data();
+		a_out.Format(
+			"GetPlacementHintForGearNode({}) {} {}",
+			gearNodeIdArgument.data(),
+			comparisonArgument.data(),
+			weaponPlacementIdArgument.data());
 	}
 
 	RE::BSString IEDNodePlacementCondition::GetCurrent(RE::TESObjectREFR* a_refr) const
@@ -43,18 +486,145 @@ namespace Conditions
 		return ""sv;
 	}
 
-	bool IEDNodePlacementCondition::EvaluateImpl(
+	bool IEDNodePlacementCondition::EvaluateResolved(
+		const ConditionBase::State&            a_state,
 		RE::TESObjectREFR*                     a_refr,
 		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
 		const
 	{
+		const auto& state = static_cast<const State&>(a_state);
+
 		const auto gearNodeID       = static_cast<GearNodeID>(gearNodeIDComponent->GetNumericValue(a_refr));
-		const auto placementID      = g_interfaceIED->GetPlacementHintForGearNode(a_refr, gearNodeID);
+		const auto placementID      = ActorCache::GetPlacementHintForGearNode(a_refr, gearNodeID);
 		const auto valuePlacementID = static_cast<WeaponPlacementID>(weaponPlacementIDComponent->GetNumericValue(a_refr));
 
-		return comparisonComponent->GetComparisonResult(
-			static_cast<float>(placementID),
-			static_cast<float>(valuePlacementID));
+		Capture::AddResponse(stl::to_underlying(placementID));
+
+		return state.comparison(
+			stl::to_underlying(placementID),
+			stl::to_underlying(valuePlacementID));
+	}
+
+	std::unique_ptr<ConditionBase::State> IEDNodePlacementCondition::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		result->comparison.Resolve(comparisonComponent);
+
+		return result;
+	}
+
+	IEDNodesPlacementCondition::IEDNodesPlacementCondition()
+	{
+		gearNodeMaskComponent      = static_cast<INumericConditionComponent*>(AddBaseComponent(
+            ConditionComponentType::kNumeric,
+            "Gear node mask"));
+		comparisonComponent        = static_cast<IComparisonConditionComponent*>(AddBaseComponent(
+            ConditionComponentType::kComparison,
+            "Comparison"));
+		weaponPlacementIDComponent = static_cast<INumericConditionComponent*>(AddBaseComponent(
+			ConditionComponentType::kNumeric,
+			"Weapon placement ID"));
+		matchAllComponent          = static_cast<IBoolConditionComponent*>(AddBaseComponent(
+            ConditionComponentType::kBool,
+            "Match all"));
+
+		AddCacheTimeComponent();
+		AddClipCacheComponent();
+	}
+
+	void IEDNodesPlacementCondition::FormatArgument(ArgumentBuffer& a_out) const
+	{
+		const auto gearNodeMaskArgument      = gearNodeMaskComponent->GetArgument();
+		const auto comparisonArgument        = comparisonComponent->GetArgument();
+		const auto weaponPlacementIdArgument = weaponPlacementIDComponent->GetArgument();
+
+		a_out.Format(
+			"{}(GetPlacementHintForGearNode(n) {} {}, n in {})",
+			matchAllComponent->GetBoolValue() ? "all" : "any",
+			comparisonArgument.data(),
+			weaponPlacementIdArgument.data(),
+			gearNodeMaskArgument.data());
+	}
+
+	RE::BSString IEDNodesPlacementCondition::GetCurrent(RE::TESObjectREFR* a_refr) const
+	{
+		if (!a_refr)
+		{
+			return ""sv;
+		}
+
+		const auto mask = static_cast<std::uint32_t>(gearNodeMaskComponent->GetNumericValue(a_refr)) & ActorCache::PlacementCache::GEAR_NODE_MASK;
+
+		std::string result;
+
+		for (auto bits = mask; bits; bits &= bits - 1)
+		{
+			const auto gearNodeID  = static_cast<PluginInterfaceIED::GearNodeID>(std::countr_zero(bits));
+			const auto placementID = g_interfaceIED->GetPlacementHintForGearNode(a_refr, gearNodeID);
+
+			std::format_to(std::back_inserter(result), "{}{}: {}", result.empty() ? "" : ", ", stl::to_underlying(gearNodeID), stl::to_underlying(placementID));
+		}
+
+		return result.c_str();
+	}
+
+	bool IEDNodesPlacementCondition::EvaluateResolved(
+		const ConditionBase::State&            a_state,
+		RE::TESObjectREFR*                     a_refr,
+		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
+		const
+	{
+		const auto& state = static_cast<const State&>(a_state);
+
+		const auto mask = static_cast<std::uint32_t>(gearNodeMaskComponent->GetNumericValue(a_refr)) & ActorCache::PlacementCache::GEAR_NODE_MASK;
+		if (!mask)
+		{
+			return false;
+		}
+
+		ActorCache::PlacementCache::GearNodePlacements placements;
+		ActorCache::GetPlacementHintsForGearNodes(a_refr, mask, placements);
+
+		const auto valuePlacementID = stl::to_underlying(static_cast<WeaponPlacementID>(weaponPlacementIDComponent->GetNumericValue(a_refr)));
+
+		// placements of the selected nodes in mask order, 4 bits each, so a full mask fits the record
+		std::uint32_t packed = 0;
+		std::uint32_t shift  = 0;
+
+		for (auto bits = mask; bits; bits &= bits - 1)
+		{
+			packed |= static_cast<std::uint32_t>(stl::to_underlying(placements[std::countr_zero(bits)]) & 0xF) << shift;
+			shift += 4;
+
+			if (shift == 32 || (bits & (bits - 1)) == 0)
+			{
+				Capture::AddResponse(static_cast<std::int32_t>(packed));
+				packed = 0;
+				shift  = 0;
+			}
+		}
+
+		for (auto bits = mask; bits; bits &= bits - 1)
+		{
+			const auto match = state.comparison(stl::to_underlying(placements[std::countr_zero(bits)]), valuePlacementID);
+			if (match != state.matchAll)
+			{
+				return match;
+			}
+		}
+
+		return state.matchAll;
+	}
+
+	std::unique_ptr<ConditionBase::State> IEDNodesPlacementCondition::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		result->comparison.Resolve(comparisonComponent);
+		result->matchAll = matchAllComponent->GetBoolValue();
+
+		return result;
 	}
 
 	IEDNodeEquippedPlacementCondition::IEDNodeEquippedPlacementCondition()
@@ -68,46 +638,62 @@ namespace Conditions
 		weaponPlacementIDComponent = static_cast<INumericConditionComponent*>(AddBaseComponent(
 			ConditionComponentType::kNumeric,
 			"Weapon placement ID"));
+
+		AddCacheTimeComponent();
+		AddClipCacheComponent();
 	}
 
-	RE::BSString IEDNodeEquippedPlacementCondition::GetArgument() const
+	void IEDNodeEquippedPlacementCondition::FormatArgument(ArgumentBuffer& a_out) const
 	{
 		const auto isLeftHandArgument        = isLeftHandComponent->GetArgument();
 		const auto comparisonArgument        = comparisonComponent->GetArgument();
 		const auto weaponPlacementIdArgument = weaponPlacementIDComponent->GetArgument();
 
-		return std::format(
-				   "GetPlacementHintForEquippedWeapon({}) {} {}",
-				   isLeftHandArgument.data(),
-				   comparisonArgument.data(),
-				   weaponPlacementIdArgument.data())
-		    .data();
+		a_out.Format(
+			"GetPlacementHintForEquippedWeapon({}) {} {}",
+			isLeftHandArgument.data(),
+			comparisonArgument.data(),
+			weaponPlacementIdArgument.data());
 	}
 
 	RE::BSString IEDNodeEquippedPlacementCondition::GetCurrent(RE::TESObjectREFR* a_refr) const
 	{
 		if (a_refr)
 		{
-			const auto isLeftHand  = isLeftHandComponent->GetBoolValue();
-			const auto placementID = g_interfaceIED->GetPlacementHintForEquippedWeapon(a_refr, isLeftHand);
+			const auto leftHand    = isLeftHandComponent->GetBoolValue();
+			const auto placementID = g_interfaceIED->GetPlacementHintForEquippedWeapon(a_refr, leftHand);
 			return std::to_string(stl::to_underlying(placementID)).data();
 		}
 
 		return ""sv;
 	}
 
-	bool IEDNodeEquippedPlacementCondition::EvaluateImpl(
+	bool IEDNodeEquippedPlacementCondition::EvaluateResolved(
+		const ConditionBase::State&            a_state,
 		RE::TESObjectREFR*                     a_refr,
 		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
 		const
 	{
-		const auto isLeftHand       = isLeftHandComponent->GetBoolValue();
-		const auto placementID      = g_interfaceIED->GetPlacementHintForEquippedWeapon(a_refr, isLeftHand);
+		const auto& state = static_cast<const State&>(a_state);
+
+		const auto placementID      = ActorCache::GetPlacementHintForEquippedWeapon(a_refr, state.isLeftHand);
 		const auto valuePlacementID = static_cast<WeaponPlacementID>(weaponPlacementIDComponent->GetNumericValue(a_refr));
 
-		return comparisonComponent->GetComparisonResult(
-			static_cast<float>(placementID),
-			static_cast<float>(valuePlacementID));
+		Capture::AddResponse(stl::to_underlying(placementID));
+
+		return state.comparison(
+			stl::to_underlying(placementID),
+			stl::to_underlying(valuePlacementID));
+	}
+
+	std::unique_ptr<ConditionBase::State> IEDNodeEquippedPlacementCondition::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		result->isLeftHand = isLeftHandComponent->GetBoolValue();
+		result->comparison.Resolve(comparisonComponent);
+
+		return result;
 	}
 
 	IEDNodeParentNameCondition::IEDNodeParentNameCondition()
@@ -118,18 +704,24 @@ namespace Conditions
 		matchTextComponent  = static_cast<ITextConditionComponent*>(AddBaseComponent(
             ConditionComponentType::kText,
             "Node name"));
+		usePatternComponent = static_cast<IBoolConditionComponent*>(AddBaseComponent(
+			ConditionComponentType::kBool,
+			"Pattern"));
+
+		AddCacheTimeComponent();
+		AddClipCacheComponent();
 	}
 
-	RE::BSString IEDNodeParentNameCondition::GetArgument() const
+	void IEDNodeParentNameCondition::FormatArgument(ArgumentBuffer& a_out) const
 	{
 		const auto gearNodeIdArgument = gearNodeIDComponent->GetArgument();
 		const auto matchTextArgument  = matchTextComponent->GetArgument();
 
-		return std::format(
-				   "GetGearNodeParentName({}) == \"{}\"",
-				   gearNodeIdArgument.data(),
-				   matchTextArgument.data())
-		    .data();
+		a_out.Format(
+			"GetGearNodeParentName({}) {} \"{}\"",
+			gearNodeIdArgument.data(),
+			usePatternComponent->GetBoolValue() ? "like" : "==",
+			matchTextArgument.data());
 	}
 
 	RE::BSString IEDNodeParentNameCondition::GetCurrent(RE::TESObjectREFR* a_refr) const
@@ -143,13 +735,107 @@ namespace Conditions
 		return "";
 	}
 
-	bool IEDNodeParentNameCondition::EvaluateImpl(RE::TESObjectREFR* a_refr, [[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
+	std::unique_ptr<ConditionBase::State> IEDNodeParentNameCondition::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		const auto text   = matchTextComponent->GetTextValue();
+		result->matchName = text.c_str();
+
+		result->usePattern = usePatternComponent->GetBoolValue();
+		if (result->usePattern)
+		{
+			result->matchPattern = NodeNamePattern(text.c_str());
+		}
+
+		return result;
+	}
+
+	bool IEDNodeParentNameCondition::EvaluateResolved(
+		const ConditionBase::State&            a_state,
+		RE::TESObjectREFR*                     a_refr,
+		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
+		const
+	{
+		const auto& state = static_cast<const State&>(a_state);
+
+		const auto gearNodeID = static_cast<GearNodeID>(gearNodeIDComponent->GetNumericValue(a_refr));
+
+		const auto parentName = GetGearNodeParentName(a_refr, gearNodeID);
+		Capture::AddResponse(parentName.c_str());
+
+		if (state.usePattern)
+		{
+			return state.matchPattern.Match(parentName.c_str());
+		}
+
+		return StringHelpers::iequals(parentName.c_str(), state.matchName.c_str());
+	}
+
+	IEDNodeParentNameInListCondition::IEDNodeParentNameInListCondition()
+	{
+		gearNodeIDComponent = static_cast<INumericConditionComponent*>(AddBaseComponent(
+			ConditionComponentType::kNumeric,
+			"Gear node ID"));
+		matchTextComponent  = static_cast<ITextConditionComponent*>(AddBaseComponent(
+            ConditionComponentType::kText,
+            "Node names"));
+
+		AddCacheTimeComponent();
+		AddClipCacheComponent();
+	}
+
+	void IEDNodeParentNameInListCondition::FormatArgument(ArgumentBuffer& a_out) const
+	{
+		const auto gearNodeIdArgument = gearNodeIDComponent->GetArgument();
+		const auto matchTextArgument  = matchTextComponent->GetArgument();
+
+		a_out.Format(
+			"GetGearNodeParentName({}) in [{}]",
+			gearNodeIdArgument.data(),
+			matchTextArgument.data());
+	}
+
+	RE::BSString IEDNodeParentNameInListCondition::GetCurrent(RE::TESObjectREFR* a_refr) const
+	{
+		if (a_refr)
+		{
+			const auto gearNodeID = static_cast<GearNodeID>(gearNodeIDComponent->GetNumericValue(a_refr));
+			return g_interfaceIED->GetGearNodeParentName(a_refr, gearNodeID);
+		}
+
+		return "";
+	}
+
+	std::unique_ptr<ConditionBase::State> IEDNodeParentNameInListCondition::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		const auto text = matchTextComponent->GetTextValue();
+		result->matchNames = NodeNameSet(text.c_str(), DELIMITER);
+
+		return result;
+	}
+
+	bool IEDNodeParentNameInListCondition::EvaluateResolved(
+		const ConditionBase::State&            a_state,
+		RE::TESObjectREFR*                     a_refr,
+		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
 		const
 	{
+		const auto& state = static_cast<const State&>(a_state);
+
+		if (state.matchNames.empty())
+		{
+			return false;
+		}
+
 		const auto gearNodeID = static_cast<GearNodeID>(gearNodeIDComponent->GetNumericValue(a_refr));
-		const auto parentName = g_interfaceIED->GetGearNodeParentName(a_refr, gearNodeID);
 
-		return parentName == matchTextComponent->GetTextValue();
+		const auto parentName = GetGearNodeParentName(a_refr, gearNodeID);
+		Capture::AddResponse(parentName.c_str());
+
+		return !parentName.empty() && state.matchNames.Contains(parentName.c_str());
 	}
 
 	IEDHasEquipmentSlot::IEDHasEquipmentSlot()
@@ -159,64 +845,89 @@ namespace Conditions
 			"Left hand"));
 		matchFormComponent  = static_cast<IFormConditionComponent*>(AddBaseComponent(
             ConditionComponentType::kForm,
-            "Equipment slot"));
+            "Equipment slot",
+            "An equip slot, a weapon, or a form list of equip slots and weapons"));
+
+		AddCacheTimeComponent();
+		AddClipCacheComponent();
 	}
 
-	RE::BSString IEDHasEquipmentSlot::GetArgument() const
+	void IEDHasEquipmentSlot::FormatArgument(ArgumentBuffer& a_out) const
 	{
 		const auto isLeftHandArgument = isLeftHandComponent->GetArgument();
 		const auto formArgument       = matchFormComponent->GetArgument();
 
-		return std::format(
-				   "GetSlotForEquippedItem({}) == {}",
-				   isLeftHandArgument.data(),
-				   formArgument.data())
-		    .data();
+		a_out.Format(
+			"GetSlotForEquippedItem({}) == {}",
+			isLeftHandArgument.data(),
+			formArgument.data());
 	}
 
 	RE::BSString IEDHasEquipmentSlot::GetCurrent(RE::TESObjectREFR* a_refr) const
 	{
 		if (a_refr)
 		{
-			const auto isLeftHand = isLeftHandComponent->GetBoolValue();
-			const auto equipSlot  = GetEquipSlotForEquippedItem(a_refr, isLeftHand);
+			const auto leftHand  = isLeftHandComponent->GetBoolValue();
+			const auto equipSlot = GetEquipSlotForEquippedItem(a_refr, leftHand);
 			return equipSlot ? std::format("0x{:X}", equipSlot->formID).data() : "";
 		}
 
 		return ""sv;
 	}
 
-	bool IEDHasEquipmentSlot::EvaluateImpl(
+	bool IEDHasEquipmentSlot::EvaluateResolved(
+		const ConditionBase::State&            a_state,
 		RE::TESObjectREFR*                     a_refr,
 		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
 		const
 	{
-		const auto matchForm = matchFormComponent->GetTESFormValue();
-		if (!matchForm)
+		const auto& state = static_cast<const State&>(a_state);
+
+		if (state.matchFormIDs.empty())
 		{
 			return false;
 		}
 
-		const auto isLeftHand = isLeftHandComponent->GetBoolValue();
-		const auto equipSlot  = GetEquipSlotForEquippedItem(a_refr, isLeftHand);
+		const auto hand = ActorCache::GetEquippedHand(a_refr, state.isLeftHand);
+
+		Capture::AddResponse(static_cast<std::int32_t>(hand.equipSlot ? hand.equipSlot->GetFormID() : 0));
 
-		return equipSlot && equipSlot == matchForm;
+		return state.IsMatch(hand.equipSlot) || (hand.isWeapon && state.IsMatch(hand.object));
+	}
+
+	std::unique_ptr<ConditionBase::State> IEDHasEquipmentSlot::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		result->isLeftHand   = isLeftHandComponent->GetBoolValue();
+		result->matchForm    = matchFormComponent->GetTESFormValue();
+		result->matchFormIDs = GetSortedFormIDs(result->matchForm);
+
+		ShareResults(*result, { result->isLeftHand, result->matchForm ? result->matchForm->GetFormID() : 0 });
+
+		return result;
 	}
 
 	RE::BGSEquipSlot* IEDHasEquipmentSlot::GetEquipSlotForEquippedItem(
 		RE::TESObjectREFR* a_refr,
 		bool               a_leftHand)
 	{
-		const auto actor = a_refr ? a_refr->As<RE::Actor>() : nullptr;
-		if (!actor)
+		return ActorCache::GetEquippedHand(a_refr, a_leftHand).equipSlot;
+	}
+
+	bool IEDHasEquipmentSlot::State::IsMatch(const RE::TESForm* a_form) const noexcept
+	{
+		if (!a_form)
 		{
-			return nullptr;
+			return false;
 		}
 
-		const auto equippedObject = actor->GetEquippedObject(a_leftHand);
-		const auto equipType      = equippedObject ? equippedObject->As<RE::BGSEquipType>() : nullptr;
+		if (matchFormIDs.size() == 1)
+		{
+			return matchFormIDs.front() == a_form->GetFormID();
+		}
 
-		return equipType ? equipType->equipSlot : nullptr;
+		return std::ranges::binary_search(matchFormIDs, a_form->GetFormID());
 	}
 
 	IEDIsBoundWeaponEquipped::IEDIsBoundWeaponEquipped()
@@ -224,56 +935,149 @@ namespace Conditions
 		isLeftHandComponent = static_cast<IBoolConditionComponent*>(AddBaseComponent(
 			ConditionComponentType::kBool,
 			"Left hand"));
+
+		AddCacheTimeComponent();
+		AddClipCacheComponent();
 	}
 
-	RE::BSString IEDIsBoundWeaponEquipped::GetArgument() const
+	void IEDIsBoundWeaponEquipped::FormatArgument(ArgumentBuffer& a_out) const
 	{
 		const auto isLeftHandArgument = isLeftHandComponent->GetArgument();
 
-		return std::format(
-				   "IsBoundWeaponEquipped({}) == true",
-				   isLeftHandArgument.data())
-		    .data();
+		a_out.Format(
+			"IsBoundWeaponEquipped({}) == true",
+			isLeftHandArgument.data());
 	}
 
 	RE::BSString IEDIsBoundWeaponEquipped::GetCurrent(RE::TESObjectREFR* a_refr) const
 	{
 		if (a_refr)
 		{
-			const auto isLeftHand = isLeftHandComponent->GetBoolValue();
-			return std::format("{}", isLeftHand).data();
+			const auto leftHand = isLeftHandComponent->GetBoolValue();
+			return std::format("{}", leftHand).data();
 		}
 
 		return ""sv;
 	}
 
-	bool IEDIsBoundWeaponEquipped::EvaluateImpl(
+	bool IEDIsBoundWeaponEquipped::EvaluateResolved(
+		const ConditionBase::State&            a_state,
 		RE::TESObjectREFR*                     a_refr,
 		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
 		const
 	{
-		const auto isLeftHand = isLeftHandComponent->GetBoolValue();
+		const auto& state = static_cast<const State&>(a_state);
 
-		return IsBoundWeaponEquipped(a_refr, isLeftHand);
+		const auto result = IsBoundWeaponEquipped(a_refr, state.isLeftHand);
+
+		Capture::AddResponse(result);
+
+		return result;
+	}
+
+	std::unique_ptr<ConditionBase::State> IEDIsBoundWeaponEquipped::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		result->isLeftHand = isLeftHandComponent->GetBoolValue();
+
+		ShareResults(*result, { result->isLeftHand });
+
+		return result;
 	}
 
 	bool IEDIsBoundWeaponEquipped::IsBoundWeaponEquipped(RE::TESObjectREFR* a_refr, bool a_leftHand)
 	{
-		const auto actor = a_refr ? a_refr->As<RE::Actor>() : nullptr;
-		if (!actor)
+		return ActorCache::GetEquippedHand(a_refr, a_leftHand).isBound;
+	}
+
+	IEDEquippedWeaponTraitsCondition::IEDEquippedWeaponTraitsCondition()
+	{
+		isLeftHandComponent      = static_cast<IBoolConditionComponent*>(AddBaseComponent(
+            ConditionComponentType::kBool,
+            "Left hand"));
+		requiredTraitsComponent  = static_cast<INumericConditionComponent*>(AddBaseComponent(
+			ConditionComponentType::kNumeric,
+			"Required traits",
+			"Sum of the trait bits the item must have, see the README for the values."));
+		forbiddenTraitsComponent = static_cast<INumericConditionComponent*>(AddBaseComponent(
+			ConditionComponentType::kNumeric,
+			"Forbidden traits",
+			"Sum of the trait bits the item must not have, see the README for the values."));
+
+		AddCacheTimeComponent();
+		AddClipCacheComponent();
+	}
+
+	void IEDEquippedWeaponTraitsCondition::FormatArgument(ArgumentBuffer& a_out) const
+	{
+		const auto isLeftHandArgument      = isLeftHandComponent->GetArgument();
+		const auto requiredTraitsArgument  = requiredTraitsComponent->GetArgument();
+		const auto forbiddenTraitsArgument = forbiddenTraitsComponent->GetArgument();
+
+		a_out.Format(
+			"GetEquippedWeaponTraits({}) has all of {}, none of {}",
+			isLeftHandArgument.data(),
+			requiredTraitsArgument.data(),
+			forbiddenTraitsArgument.data());
+	}
+
+	RE::BSString IEDEquippedWeaponTraitsCondition::GetCurrent(RE::TESObjectREFR* a_refr) const
+	{
+		if (a_refr)
 		{
-			return false;
+			const auto leftHand = isLeftHandComponent->GetBoolValue();
+			const auto hand     = ActorCache::GetEquippedHand(a_refr, leftHand);
+			return std::format("0x{:X}", hand.traits).data();
 		}
 
-		const auto equippedObject = actor->GetEquippedObject(a_leftHand);
-		const auto weapon         = equippedObject ? equippedObject->As<RE::TESObjectWEAP>() : nullptr;
+		return ""sv;
+	}
+
+	bool IEDEquippedWeaponTraitsCondition::EvaluateResolved(
+		const ConditionBase::State&            a_state,
+		RE::TESObjectREFR*                     a_refr,
+		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
+		const
+	{
+		const auto& state = static_cast<const State&>(a_state);
+
+		const auto required  = static_cast<std::uint32_t>(requiredTraitsComponent->GetNumericValue(a_refr));
+		const auto forbidden = static_cast<std::uint32_t>(forbiddenTraitsComponent->GetNumericValue(a_refr));
+		const auto traits    = ActorCache::GetEquippedHand(a_refr, state.isLeftHand).traits;
 
-		return weapon && weapon->IsBound();
+		Capture::AddResponse(static_cast<std::int32_t>(traits));
+
+		return (traits & required) == required && (traits & forbidden) == 0;
 	}
 
-	RE::BSString SDSShieldOnBackEnabledCondition::GetArgument() const
+	std::unique_ptr<ConditionBase::State> IEDEquippedWeaponTraitsCondition::ResolveComponents() const
 	{
-		return "IsShieldOnBackEnabled() == true"sv;
+		auto result = std::make_unique<State>();
+
+		result->isLeftHand = isLeftHandComponent->GetBoolValue();
+
+		return result;
+	}
+
+	SDSShieldOnBackEnabledCondition::SDSShieldOnBackEnabledCondition()
+	{
+		AddCacheTimeComponent();
+		AddClipCacheComponent();
+	}
+
+	void SDSShieldOnBackEnabledCondition::FormatArgument(ArgumentBuffer& a_out) const
+	{
+		a_out.Format("IsShieldOnBackEnabled() == true");
+	}
+
+	std::unique_ptr<ConditionBase::State> SDSShieldOnBackEnabledCondition::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		ShareResults(*result, {});
+
+		return result;
 	}
 
 	RE::BSString SDSShieldOnBackEnabledCondition::GetCurrent(RE::TESObjectREFR* a_refr) const
@@ -292,13 +1096,18 @@ namespace Conditions
 		return "false"sv;
 	}
 
-	bool SDSShieldOnBackEnabledCondition::EvaluateImpl(
+	bool SDSShieldOnBackEnabledCondition::EvaluateResolved(
+		[[maybe_unused]] const State&          a_state,
 		RE::TESObjectREFR*                     a_refr,
 		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
 		const
 	{
-		auto actor = a_refr ? a_refr->As<RE::Actor>() : nullptr;
-		return actor ? g_interfaceSDS->GetShieldOnBackEnabled(actor) : false;
+		const auto actor  = a_refr ? a_refr->As<RE::Actor>() : nullptr;
+		const auto result = actor ? ActorCache::GetShieldOnBackEnabled(actor) : false;
+
+		Capture::AddResponse(result);
+
+		return result;
 	}
 
 	IEDPluginOptionCondition::IEDPluginOptionCondition()
@@ -314,20 +1123,21 @@ namespace Conditions
 		matchValueComponent = static_cast<INumericConditionComponent*>(AddBaseComponent(
 			ConditionComponentType::kNumeric,
 			"Match value"));
+
+		AddCacheTimeComponent();
 	}
 
-	RE::BSString IEDPluginOptionCondition::GetArgument() const
+	void IEDPluginOptionCondition::FormatArgument(ArgumentBuffer& a_out) const
 	{
 		const auto keyArgument        = optionKeyComponent->GetArgument();
 		const auto comparisonArgument = comparisonComponent->GetArgument();
 		const auto valueArgument      = matchValueComponent->GetArgument();
 
-		return std::format(
-				   "GetPluginOption({}) {} {}",
-				   keyArgument.data(),
-				   comparisonArgument.data(),
-				   valueArgument.data())
-		    .data();
+		a_out.Format(
+			"GetPluginOption({}) {} {}",
+			keyArgument.data(),
+			comparisonArgument.data(),
+			valueArgument.data());
 	}
 
 	RE::BSString IEDPluginOptionCondition::GetCurrent(RE::TESObjectREFR* a_refr) const
@@ -337,17 +1147,66 @@ namespace Conditions
 		return std::format("{}", static_cast<std::int32_t>(value)).data();
 	}
 
-	bool IEDPluginOptionCondition::EvaluateImpl(
+	bool IEDPluginOptionCondition::EvaluateResolved(
+		const ConditionBase::State&            a_state,
 		RE::TESObjectREFR*                     a_refr,
 		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator) const
 	{
-		const auto key        = static_cast<PluginOptionKey>(optionKeyComponent->GetNumericValue(a_refr));
-		const auto value      = g_interfaceIED->GetPluginOption(key);
-		const auto matchValue = static_cast<PluginOptionKey>(matchValueComponent->GetNumericValue(a_refr));
+		const auto& state = static_cast<const State&>(a_state);
+
+		const auto key   = static_cast<PluginOptionKey>(optionKeyComponent->GetNumericValue(a_refr));
+		const auto value = SettingsSnapshot::GetPluginOption(key);
+		const auto match = static_cast<std::int32_t>(matchValueComponent->GetNumericValue(a_refr));
+
+		Capture::AddResponse(value);
 
-		return comparisonComponent->GetComparisonResult(
-			static_cast<float>(value),
-			static_cast<float>(matchValue));
+		return state.comparison(value, match);
+	}
+
+	std::unique_ptr<ConditionBase::State> IEDPluginOptionCondition::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		result->comparison.Resolve(comparisonComponent);
+
+		return result;
+	}
+
+	SDSWeaponNodeSharingDisabledCondition::SDSWeaponNodeSharingDisabledCondition()
+	{
+		AddCacheTimeComponent();
+	}
+
+	std::unique_ptr<ConditionBase::State> SDSWeaponNodeSharingDisabledCondition::ResolveComponents() const
+	{
+		auto result = std::make_unique<State>();
+
+		ShareResults(*result, {});
+
+		return result;
+	}
+
+	RE::BSString SDSWeaponNodeSharingDisabledCondition::GetCurrent([[maybe_unused]] RE::TESObjectREFR* a_refr) const
+	{
+		return g_interfaceSDS->IsWeaponNodeSharingDisabled() ? "true"sv : "false"sv;
+	}
+
+	bool SDSWeaponNodeSharingDisabledCondition::EvaluateResolved(
+		[[maybe_unused]] const State&          a_state,
+		[[maybe_unused]] RE::TESObjectREFR*    a_refr,
+		[[maybe_unused]] RE::hkbClipGenerator* a_clipGenerator)
+		const
+	{
+		const auto result = SettingsSnapshot::IsWeaponNodeSharingDisabled();
+
+		Capture::AddResponse(result);
+
+		return result;
+	}
+
+	void SDSWeaponNodeSharingDisabledCondition::FormatArgument(ArgumentBuffer& a_out) const
+	{
+		a_out.Format("IsWeaponNodeSharingDisabled() == true");
 	}
 
 }
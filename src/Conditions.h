@@ -2,9 +2,177 @@
 
 #include "API/OpenAnimationReplacerAPI-Conditions.h"
 
+#include "ConditionID.h"
+#include "NodeNamePattern.h"
+#include "NodeNameSet.h"
+#include "SharedResults.h"
+
 namespace Conditions
 {
-	class IEDNodePlacementCondition : public CustomCondition
+	// null-terminated text buffer that arguments are rendered into, text that doesn't fit the fixed capacity
+	// (long form or node name lists) is rendered again on the heap rather than cut off
+	class ArgumentBuffer
+	{
+	public:
+		static constexpr std::size_t CAPACITY = 512;
+
+		template <class... Args>
+		void Format(std::format_string<Args...> a_fmt, Args&&... a_args)
+		{
+			const auto result = std::format_to_n(buffer.data(), CAPACITY - 1, a_fmt, std::forward<Args>(a_args)...);
+			*result.out       = 0;
+
+			if (static_cast<std::size_t>(result.size) >= CAPACITY)
+			{
+				// formatting only reads the arguments, forwarding them a second time is safe
+				overflow = std::format(a_fmt, std::forward<Args>(a_args)...);
+			}
+			else
+			{
+				overflow.clear();
+			}
+		}
+
+		[[nodiscard]] const char* c_str() const noexcept { return overflow.empty() ? buffer.data() : overflow.c_str(); }
+
+	private:
+		std::array<char, CAPACITY> buffer{};
+		std::string                overflow;
+	};
+
+	// integer comparison kernel selected once from a comparison component's operator
+	class IntegerComparison
+	{
+	public:
+		void Resolve(const IComparisonConditionComponent* a_component);
+
+		[[nodiscard]] bool operator()(std::int32_t a_lhs, std::int32_t a_rhs) const { return func(a_lhs, a_rhs); }
+
+	private:
+		using func_t = bool (*)(std::int32_t, std::int32_t);
+
+		template <class Op>
+		static bool Compare(std::int32_t a_lhs, std::int32_t a_rhs)
+		{
+			return Op{}(a_lhs, a_rhs);
+		}
+
+		static bool Never(std::int32_t, std::int32_t) { return false; }
+
+		func_t func{ Compare<std::equal_to<>> };
+	};
+
+	// common base of the conditions in this plugin
+	class ConditionBase : public CustomCondition
+	{
+	public:
+		~ConditionBase() override;
+
+		bool Evaluate(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+
+		// the argument text is rendered once and reused until PostInitialize runs again (load or component edit)
+		RE::BSString GetArgument() const final;
+
+		void PostInitialize() final;
+
+		void SetDisabled(bool a_disabled) override;
+		void SetNegated(bool a_negated) override;
+
+		[[nodiscard]] virtual ConditionID GetID() const = 0;
+
+	protected:
+		// component values resolved by ResolveComponents, never modified once published
+		// conditions with values of their own derive from it and cast it back in EvaluateResolved
+		struct State
+		{
+			virtual ~State() = default;
+
+			std::uint32_t                  cacheTime{ 0 };
+			bool                           useClipCache{ false };
+			std::shared_ptr<SharedResults> sharedResults;  // released with the state
+		};
+
+		// adds the optional 'Cache (ms)' component, results for a ref are then reused until the time has passed
+		void AddCacheTimeComponent();
+
+		// adds the opt-in 'Cache per clip' component, call last in the constructor of conditions whose result may be kept for a whole clip
+		void AddClipCacheComponent();
+
+		virtual void FormatArgument(ArgumentBuffer& a_out) const = 0;
+
+		// builds a state from the current component values, called after the condition was loaded or edited
+		[[nodiscard]] virtual std::unique_ptr<State> ResolveComponents() const = 0;
+
+		// EvaluateImpl with the state that was published when the evaluation started
+		[[nodiscard]] virtual bool EvaluateResolved(const State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const = 0;
+
+		bool EvaluateImpl(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const final;
+
+		// call from ResolveComponents once every argument the result depends on is known,
+		// instances of the same type with equal arguments then evaluate once per ref per frame
+		void ShareResults(State& a_state, std::initializer_list<std::uint64_t> a_arguments) const;
+
+	private:
+		struct ClipResult
+		{
+			const State*  state;  // results of a replaced state are not reused
+			std::uint32_t activation;
+			RE::FormID    formID;
+			bool          result;
+		};
+
+		struct TimedResult
+		{
+			const State*  state;
+			std::uint32_t time;  // application run time in ms when evaluated
+			bool          result;
+		};
+
+		static constexpr std::size_t MAX_CLIP_RESULTS  = 1024;
+		static constexpr std::size_t MAX_TIMED_RESULTS = 1024;
+
+		[[nodiscard]] std::unique_ptr<State> Resolve() const;
+		[[nodiscard]] const State&           GetState() const;
+
+		// makes a_state the current state and keeps the clip cache user count of Hooks in step with it, stateLock held
+		const State& Publish(std::unique_ptr<State> a_state) const;
+
+		void ClearCachedResults() const;
+
+		// adds the value of every component but the cache options to the capture record, see Capture.h
+		void CaptureArguments(RE::TESObjectREFR* a_refr) const;
+
+		// the result for a clip generator is reused until it is activated or deactivated again
+		[[nodiscard]] bool EvaluateWithClipCache(const State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const;
+
+		// the result for a ref is reused until cacheTime ms have passed
+		[[nodiscard]] bool EvaluateWithTimedCache(const State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const;
+
+		// CustomCondition::Evaluate with the EvaluateResolved result taken from the shared slot when there is one, negation stays per instance
+		[[nodiscard]] bool EvaluateWithSharedResults(const State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const;
+
+		INumericConditionComponent* cacheTimeComponent{ nullptr };
+		IBoolConditionComponent*    clipCacheComponent{ nullptr };
+
+		// evaluating threads read the current state without locking, replaced states are kept until the condition
+		// is destroyed since an evaluation may still be using one (a replacement per load or edit)
+		mutable std::atomic<const State*>                 state{ nullptr };
+		mutable std::mutex                                stateLock;
+		mutable std::vector<std::unique_ptr<const State>> states;
+		mutable bool                                      clipCacheUser{ false };  // counted by Hooks::AddClipCacheUser
+
+		mutable std::shared_mutex                                            clipResultsLock;
+		mutable std::unordered_map<const RE::hkbClipGenerator*, ClipResult> clipResults;
+
+		mutable std::shared_mutex                           timedResultsLock;
+		mutable std::unordered_map<RE::FormID, TimedResult> timedResults;
+
+		mutable std::mutex   argumentLock;
+		mutable RE::BSString argument;
+		mutable bool         argumentValid{ false };
+	};
+
+	class IEDNodePlacementCondition : public ConditionBase
 	{
 		using GearNodeID        = PluginInterfaceIED::GearNodeID;
 		using WeaponPlacementID = PluginInterfaceIED::WeaponPlacementID;
@@ -15,6 +183,7 @@ namespace Conditions
 		IEDNodePlacementCondition();
 
 		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kIEDNodePlacement; }
 
 		RE::BSString GetDescription() const override
 		{
@@ -24,19 +193,63 @@ namespace Conditions
 
 		constexpr REL::Version GetRequiredVersion() const override { return { 1, 0, 0 }; }
 
-		RE::BSString GetArgument() const override;
-
 		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
 
 	protected:
-		bool EvaluateImpl(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		struct State : ConditionBase::State
+		{
+			IntegerComparison comparison;
+		};
+
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
 
 		IComparisonConditionComponent* comparisonComponent;
 		INumericConditionComponent*    gearNodeIDComponent;
 		INumericConditionComponent*    weaponPlacementIDComponent;
 	};
 
-	class IEDNodeEquippedPlacementCondition : public CustomCondition
+	class IEDNodesPlacementCondition : public ConditionBase
+	{
+		using WeaponPlacementID = PluginInterfaceIED::WeaponPlacementID;
+
+	public:
+		constexpr static inline std::string_view CONDITION_NAME = "IED_GearNodesPlacementHint"sv;
+
+		IEDNodesPlacementCondition();
+
+		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kIEDNodesPlacement; }
+
+		RE::BSString GetDescription() const override
+		{
+			return "Checks the placement hints of several gear nodes at once against the 'Weapon placement ID' parameter according to the selected 'Comparison' operator. The gear nodes are selected by the 'Gear node mask' parameter, where bit N selects gear node ID N (e.g. 2 | 8 = 10 selects the one-handed sword and axe). Passes if any node matches, or every node with 'Match all' set."sv
+			    .data();
+		}
+
+		constexpr REL::Version GetRequiredVersion() const override { return { 1, 1, 0 }; }
+
+		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
+
+	protected:
+		struct State : ConditionBase::State
+		{
+			IntegerComparison comparison;
+			bool              matchAll{ false };
+		};
+
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
+
+		INumericConditionComponent*    gearNodeMaskComponent;
+		IComparisonConditionComponent* comparisonComponent;
+		INumericConditionComponent*    weaponPlacementIDComponent;
+		IBoolConditionComponent*       matchAllComponent;
+	};
+
+	class IEDNodeEquippedPlacementCondition : public ConditionBase
 	{
 		using GearNodeID        = PluginInterfaceIED::GearNodeID;
 		using WeaponPlacementID = PluginInterfaceIED::WeaponPlacementID;
@@ -47,6 +260,7 @@ namespace Conditions
 		IEDNodeEquippedPlacementCondition();
 
 		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kIEDNodeEquippedPlacement; }
 
 		RE::BSString GetDescription() const override
 		{
@@ -56,19 +270,25 @@ namespace Conditions
 
 		constexpr REL::Version GetRequiredVersion() const override { return { 1, 0, 0 }; }
 
-		RE::BSString GetArgument() const override;
-
 		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
 
 	protected:
-		bool EvaluateImpl(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		struct State : ConditionBase::State
+		{
+			bool              isLeftHand{ false };
+			IntegerComparison comparison;
+		};
+
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
 
 		IBoolConditionComponent*       isLeftHandComponent;
 		IComparisonConditionComponent* comparisonComponent;
 		INumericConditionComponent*    weaponPlacementIDComponent;
 	};
 
-	class IEDNodeParentNameCondition : public CustomCondition
+	class IEDNodeParentNameCondition : public ConditionBase
 	{
 		using GearNodeID = PluginInterfaceIED::GearNodeID;
 
@@ -78,27 +298,74 @@ namespace Conditions
 		IEDNodeParentNameCondition();
 
 		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kIEDNodeParentName; }
 
 		RE::BSString GetDescription() const override
 		{
-			return "Checks if the gear node's current parent node name equals the text in 'Node name' parameter. The gear node is specified by the 'Gear node ID' parameter. Case insensitive."sv
+			return "Checks if the gear node's current parent node name equals the text in 'Node name' parameter. The gear node is specified by the 'Gear node ID' parameter. With 'Pattern' enabled, '*' in the text matches any run of characters and '?' matches a single character. Case insensitive."sv
 			    .data();
 		}
 
-		constexpr REL::Version GetRequiredVersion() const override { return { 1, 0, 0 }; }
+		constexpr REL::Version GetRequiredVersion() const override { return { 1, 1, 0 }; }
+
+		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
 
-		RE::BSString GetArgument() const override;
+	protected:
+		struct State : ConditionBase::State
+		{
+			std::string     matchName;
+			NodeNamePattern matchPattern;
+			bool            usePattern{ false };
+		};
+
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
+
+		INumericConditionComponent* gearNodeIDComponent;
+		ITextConditionComponent*    matchTextComponent;
+		IBoolConditionComponent*    usePatternComponent;
+	};
+
+	class IEDNodeParentNameInListCondition : public ConditionBase
+	{
+		using GearNodeID = PluginInterfaceIED::GearNodeID;
+
+	public:
+		constexpr static inline std::string_view CONDITION_NAME = "IED_GearNodeParentNameInList"sv;
+
+		static constexpr char DELIMITER = ',';
+
+		IEDNodeParentNameInListCondition();
+
+		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kIEDNodeParentNameInList; }
+
+		RE::BSString GetDescription() const override
+		{
+			return "Checks if the gear node's current parent node name is one of the comma separated names in the 'Node names' parameter. The gear node is specified by the 'Gear node ID' parameter. Case insensitive."sv
+			    .data();
+		}
+
+		constexpr REL::Version GetRequiredVersion() const override { return { 1, 1, 0 }; }
 
 		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
 
 	protected:
-		bool EvaluateImpl(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		struct State : ConditionBase::State
+		{
+			NodeNameSet matchNames;
+		};
+
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
 
 		INumericConditionComponent* gearNodeIDComponent;
 		ITextConditionComponent*    matchTextComponent;
 	};
 
-	class IEDHasEquipmentSlot : public CustomCondition
+	class IEDHasEquipmentSlot : public ConditionBase
 	{
 	public:
 		constexpr static inline std::string_view CONDITION_NAME = "IED_HasEquipSlot"sv;
@@ -106,21 +373,33 @@ namespace Conditions
 		IEDHasEquipmentSlot();
 
 		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kIEDHasEquipmentSlot; }
 
 		RE::BSString GetDescription() const override
 		{
-			return "Checks if an item equipped in the target ref's hand has the specified equip slot configured."sv
+			return "Checks if an item equipped in the target ref's hand has the specified equip slot configured, or is the specified weapon. Accepts a form list of equip slots and weapons."sv
 			    .data();
 		}
 
 		constexpr REL::Version GetRequiredVersion() const override { return { 1, 0, 0 }; }
 
-		RE::BSString GetArgument() const override;
-
 		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
 
 	protected:
-		bool EvaluateImpl(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		struct State : ConditionBase::State
+		{
+			bool         isLeftHand{ false };
+			RE::TESForm* matchForm{ nullptr };
+
+			// sorted form IDs of matchForm, or of the equip slots and weapons in it when it is a form list
+			std::vector<RE::FormID> matchFormIDs;
+
+			[[nodiscard]] bool IsMatch(const RE::TESForm* a_form) const noexcept;
+		};
+
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
 
 		static RE::BGSEquipSlot* GetEquipSlotForEquippedItem(RE::TESObjectREFR* a_refr, bool a_leftHand);
 
@@ -128,7 +407,7 @@ namespace Conditions
 		IFormConditionComponent* matchFormComponent;
 	};
 	
-	class IEDIsBoundWeaponEquipped : public CustomCondition
+	class IEDIsBoundWeaponEquipped : public ConditionBase
 	{
 	public:
 		constexpr static inline std::string_view CONDITION_NAME = "IED_IsBoundWeaponEquipped"sv;
@@ -136,6 +415,7 @@ namespace Conditions
 		IEDIsBoundWeaponEquipped();
 
 		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kIEDIsBoundWeaponEquipped; }
 
 		RE::BSString GetDescription() const override
 		{
@@ -145,19 +425,59 @@ namespace Conditions
 
 		constexpr REL::Version GetRequiredVersion() const override { return { 1, 0, 0 }; }
 
-		RE::BSString GetArgument() const override;
-
 		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
 
 	protected:
-		bool EvaluateImpl(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		struct State : ConditionBase::State
+		{
+			bool isLeftHand{ false };
+		};
+
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
 
 		static bool IsBoundWeaponEquipped(RE::TESObjectREFR* a_refr, bool a_leftHand);
 
 		IBoolConditionComponent* isLeftHandComponent;
 	};
 
-	class IEDPluginOptionCondition : public CustomCondition
+	class IEDEquippedWeaponTraitsCondition : public ConditionBase
+	{
+	public:
+		constexpr static inline std::string_view CONDITION_NAME = "IED_EquippedWeaponTraits"sv;
+
+		IEDEquippedWeaponTraitsCondition();
+
+		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kIEDEquippedWeaponTraits; }
+
+		RE::BSString GetDescription() const override
+		{
+			return "Checks if the item equipped in the target ref's hand has all of the required traits and none of the forbidden traits."sv
+			    .data();
+		}
+
+		constexpr REL::Version GetRequiredVersion() const override { return { 1, 1, 0 }; }
+
+		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
+
+	protected:
+		struct State : ConditionBase::State
+		{
+			bool isLeftHand{ false };
+		};
+
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
+
+		IBoolConditionComponent*    isLeftHandComponent;
+		INumericConditionComponent* requiredTraitsComponent;
+		INumericConditionComponent* forbiddenTraitsComponent;
+	};
+
+	class IEDPluginOptionCondition : public ConditionBase
 	{
 		using PluginOptionKey = PluginInterfaceIED::PluginOptionKey;
 
@@ -167,6 +487,7 @@ namespace Conditions
 		IEDPluginOptionCondition();
 
 		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kIEDPluginOption; }
 
 		RE::BSString GetDescription() const override
 		{
@@ -176,24 +497,32 @@ namespace Conditions
 
 		constexpr REL::Version GetRequiredVersion() const override { return { 1, 0, 0 }; }
 
-		RE::BSString GetArgument() const override;
-
 		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
 
 	protected:
-		bool EvaluateImpl(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		struct State : ConditionBase::State
+		{
+			IntegerComparison comparison;
+		};
+
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
 
 		INumericConditionComponent*    optionKeyComponent;
 		IComparisonConditionComponent* comparisonComponent;
 		INumericConditionComponent*    matchValueComponent;
 	};
 
-	class SDSShieldOnBackEnabledCondition : public CustomCondition
+	class SDSShieldOnBackEnabledCondition : public ConditionBase
 	{
 	public:
 		constexpr static inline std::string_view CONDITION_NAME = "SDS_IsShieldOnBackEnabled"sv;
 
+		SDSShieldOnBackEnabledCondition();
+
 		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kSDSShieldOnBackEnabled; }
 
 		RE::BSString GetDescription() const override
 		{
@@ -203,11 +532,37 @@ namespace Conditions
 
 		constexpr REL::Version GetRequiredVersion() const override { return { 1, 0, 0 }; }
 
-		RE::BSString GetArgument() const override;
+		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
+
+	protected:
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
+	};
+
+	class SDSWeaponNodeSharingDisabledCondition : public ConditionBase
+	{
+	public:
+		constexpr static inline std::string_view CONDITION_NAME = "SDS_IsWeaponNodeSharingDisabled"sv;
+
+		SDSWeaponNodeSharingDisabledCondition();
+
+		RE::BSString GetName() const override { return CONDITION_NAME.data(); }
+		ConditionID  GetID() const override { return ConditionID::kSDSWeaponNodeSharingDisabled; }
+
+		RE::BSString GetDescription() const override
+		{
+			return "Checks if weapon node sharing is disabled in Simple Dual Sheath."sv
+			    .data();
+		}
+
+		constexpr REL::Version GetRequiredVersion() const override { return { 1, 1, 0 }; }
 
 		RE::BSString GetCurrent(RE::TESObjectREFR* a_refr) const override;
 
 	protected:
-		bool EvaluateImpl(RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		bool                                  EvaluateResolved(const ConditionBase::State& a_state, RE::TESObjectREFR* a_refr, RE::hkbClipGenerator* a_clipGenerator) const override;
+		void                                  FormatArgument(ArgumentBuffer& a_out) const override;
+		std::unique_ptr<ConditionBase::State> ResolveComponents() const override;
 	};
 }
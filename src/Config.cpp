@@ -0,0 +1,52 @@
+#include "Config.h"
+
+#include <SimpleIni.h>
+
+namespace Config
+{
+	namespace
+	{
+		std::string s_path;
+		bool        s_loaded{ false };
+	}
+
+	void Load()
+	{
+		const auto plugin = SKSE::PluginDeclaration::GetSingleton();
+		s_path            = std::format("Data/SKSE/Plugins/{}.ini", plugin->GetName());
+
+		CSimpleIniA ini;
+		ini.SetUnicode();
+
+		if (ini.LoadFile(s_path.c_str()) < 0)
+		{
+			return;
+		}
+
+		logQueueSize       = static_cast<std::uint32_t>(ini.GetLongValue("Logging", "iQueueSize", logQueueSize));
+		logBlockOnOverflow = ini.GetBoolValue("Logging", "bBlockOnOverflow", logBlockOnOverflow);
+		logFlushInterval   = static_cast<std::uint32_t>(ini.GetLongValue("Logging", "iFlushInterval", logFlushInterval));
+
+		consoleCommand = ini.GetValue("Console", "sCommand", consoleCommand.c_str());
+
+		profilingReportInterval = static_cast<std::uint32_t>(ini.GetLongValue("Profiling", "iReportInterval", profilingReportInterval));
+		traceHotkey             = static_cast<std::uint32_t>(ini.GetLongValue("Profiling", "iTraceHotkey", traceHotkey));
+		traceFrames             = static_cast<std::uint32_t>(ini.GetLongValue("Profiling", "iTraceFrames", traceFrames));
+		traceBufferSize         = static_cast<std::uint32_t>(ini.GetLongValue("Profiling", "iTraceBufferSize", traceBufferSize));
+		captureRecords          = static_cast<std::uint32_t>(ini.GetLongValue("Profiling", "iCaptureRecords", captureRecords));
+
+		s_loaded = true;
+	}
+
+	void LogLoadResult()
+	{
+		if (s_loaded)
+		{
+			logs::info("Loaded settings from {}"sv, s_path);
+		}
+		else
+		{
+			logs::info("{} not found, using default settings"sv, s_path);
+		}
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+// settings read from Data/SKSE/Plugins/<plugin name>.ini, missing keys keep their defaults
+namespace Config
+{
+	// runs before logging is set up, the outcome is logged by LogLoadResult
+	void Load();
+	void LogLoadResult();
+
+	// [Logging]
+	inline std::uint32_t logQueueSize       = 8192;   // messages the async logger can hold before the overflow policy applies
+	inline bool          logBlockOnOverflow = false;  // block the logging thread when the queue is full instead of dropping the oldest message
+	inline std::uint32_t logFlushInterval   = 3;      // seconds between flushes, warnings and errors are flushed immediately
+
+	// [Console]
+	inline std::string consoleCommand = "BetaComment";  // unused vanilla command that is taken over
+
+	// [Profiling]
+	inline std::uint32_t profilingReportInterval = 60;       // seconds, 0 disables periodic reports
+	inline std::uint32_t traceHotkey             = 0;        // DirectInput scan code that starts/stops a trace, 0 disables
+	inline std::uint32_t traceFrames             = 0;        // frames after which a trace stops by itself, 0 runs until stopped
+	inline std::uint32_t traceBufferSize         = 65536;    // spans kept per thread, the oldest are overwritten
+	inline std::uint32_t captureRecords          = 1048576;  // evaluation records kept in the capture file (64 bytes each), the oldest are overwritten
+}
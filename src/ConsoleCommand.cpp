@@ -0,0 +1,100 @@
+#include "ConsoleCommand.h"
+
+#include "Capture.h"
+#include "Config.h"
+#include "Profiling.h"
+#include "StringHelpers.h"
+#include "Trace.h"
+
+#if defined(ENABLE_PROFILING)
+namespace ConsoleCommand
+{
+	namespace
+	{
+		constexpr auto COMMAND_NAME = "OARIED"sv;
+		constexpr auto HELP_STRING  = "OARIED stats - log condition evaluation stats\nOARIED trace - start/stop a condition trace\nOARIED capture - start/stop capturing evaluations to a file"sv;
+
+		void Print(std::string_view a_text)
+		{
+			if (const auto console = RE::ConsoleLog::GetSingleton())
+			{
+				console->Print("%.*s", static_cast<int>(a_text.size()), a_text.data());
+			}
+		}
+
+		void ExecuteStats()
+		{
+			Profiling::Report(true);
+		}
+
+		void ExecuteTrace()
+		{
+			Trace::Toggle();
+			Print(Trace::IsActive() ? "Condition trace started"sv : "Condition trace stopped, writing to the log directory"sv);
+		}
+
+		void ExecuteCapture()
+		{
+			Capture::Toggle();
+			Print(Capture::IsActive() ? "Capture started"sv : "Capture stopped"sv);
+		}
+
+		bool Execute(
+			const RE::SCRIPT_PARAMETER*,
+			RE::SCRIPT_FUNCTION::ScriptData* a_scriptData,
+			RE::TESObjectREFR*,
+			RE::TESObjectREFR*,
+			RE::Script*,
+			RE::ScriptLocals*,
+			double&,
+			std::uint32_t&)
+		{
+			const auto chunk = a_scriptData ? a_scriptData->GetStringChunk() : nullptr;
+			const auto arg   = chunk ? chunk->GetString() : std::string{};
+
+			if (StringHelpers::iequals(arg, "stats"sv))
+			{
+				ExecuteStats();
+			}
+			else if (StringHelpers::iequals(arg, "trace"sv))
+			{
+				ExecuteTrace();
+			}
+			else if (StringHelpers::iequals(arg, "capture"sv))
+			{
+				ExecuteCapture();
+			}
+			else
+			{
+				Print(HELP_STRING);
+			}
+
+			return true;
+		}
+	}
+
+	void Install()
+	{
+		const auto command = RE::SCRIPT_FUNCTION::LocateConsoleCommand(Config::consoleCommand);
+		if (!command)
+		{
+			logs::warn("Console command {} not found, diagnostics command unavailable"sv, Config::consoleCommand);
+			return;
+		}
+
+		static RE::SCRIPT_PARAMETER params[] = {
+			{ "Command", RE::SCRIPT_PARAM_TYPE::kChar, true }
+		};
+
+		command->functionName      = COMMAND_NAME.data();
+		command->shortName         = "";
+		command->helpString        = HELP_STRING.data();
+		command->referenceFunction = false;
+		command->SetParameters(params);
+		command->executeFunction   = Execute;
+		command->conditionFunction = nullptr;
+
+		logs::info("Installed console command {} (replaces {})"sv, COMMAND_NAME, Config::consoleCommand);
+	}
+}
+#endif
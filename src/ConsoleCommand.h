@@ -0,0 +1,9 @@
+#pragma once
+
+// takes over an unused vanilla console command to expose the plugin's diagnostics, profiling builds only
+#if defined(ENABLE_PROFILING)
+namespace ConsoleCommand
+{
+	void Install();
+}
+#endif
@@ -0,0 +1,108 @@
+#include "EventHandler.h"
+
+#include "ActorCache.h"
+#include "Config.h"
+#include "SettingsSnapshot.h"
+#include "Trace.h"
+
+void EventHandler::RegisterGameEvents()
+{
+	logs::trace("Registering game event sinks...");
+
+	const auto holder = RE::ScriptEventSourceHolder::GetSingleton();
+	holder->AddEventSink<RE::TESEquipEvent>(this);
+	holder->AddEventSink<RE::TESObjectLoadedEvent>(this);
+
+	RE::UI::GetSingleton()->AddEventSink<RE::MenuOpenCloseEvent>(this);
+
+#if defined(ENABLE_PROFILING)
+	if (Config::traceHotkey)
+	{
+		RE::BSInputDeviceManager::GetSingleton()->AddEventSink<RE::InputEvent*>(this);
+	}
+#endif
+}
+
+void EventHandler::RegisterSDSEvents(PluginInterfaceSDS* a_interface)
+{
+	logs::trace("Registering SDS event sink...");
+
+	a_interface->RegisterForPlayerShieldOnBackEvent(this);
+}
+
+RE::BSEventNotifyControl EventHandler::ProcessEvent(
+	const RE::TESEquipEvent*                               a_event,
+	[[maybe_unused]] RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource)
+{
+	if (a_event && a_event->actor)
+	{
+		ActorCache::Invalidate(a_event->actor->GetFormID());
+
+		// worn armor can't be read safely from the threads that evaluate conditions, record the shield here
+		const auto actor  = a_event->actor->As<RE::Actor>();
+		const auto object = RE::TESForm::LookupByID<RE::TESObjectARMO>(a_event->baseObject);
+		if (actor && object && object->IsShield())
+		{
+			ActorCache::SetWornShield(actor, a_event->equipped);
+		}
+	}
+
+	return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl EventHandler::ProcessEvent(
+	const RE::TESObjectLoadedEvent*                               a_event,
+	[[maybe_unused]] RE::BSTEventSource<RE::TESObjectLoadedEvent>* a_eventSource)
+{
+	if (a_event)
+	{
+		ActorCache::Invalidate(a_event->formID);
+
+		const auto actor = a_event->loaded ? RE::TESForm::LookupByID<RE::Actor>(a_event->formID) : nullptr;
+		if (actor)
+		{
+			ActorCache::SetWornShield(actor, actor->GetWornArmor(RE::BGSBipedObjectForm::BipedObjectSlot::kShield) != nullptr);
+		}
+	}
+
+	return RE::BSEventNotifyControl::kContinue;
+}
+
+RE::BSEventNotifyControl EventHandler::ProcessEvent(
+	const RE::MenuOpenCloseEvent*                               a_event,
+	[[maybe_unused]] RE::BSTEventSource<RE::MenuOpenCloseEvent>* a_eventSource)
+{
+	// settings are most likely to change while a menu is open
+	if (a_event && !a_event->opening)
+	{
+		SettingsSnapshot::Refresh();
+	}
+
+	return RE::BSEventNotifyControl::kContinue;
+}
+
+#if defined(ENABLE_PROFILING)
+RE::BSEventNotifyControl EventHandler::ProcessEvent(
+	RE::InputEvent* const*                                 a_event,
+	[[maybe_unused]] RE::BSTEventSource<RE::InputEvent*>* a_eventSource)
+{
+	for (auto event = a_event ? *a_event : nullptr; event; event = event->next)
+	{
+		const auto button = event->AsButtonEvent();
+		if (button &&
+		    button->GetDevice() == RE::INPUT_DEVICE::kKeyboard &&
+		    button->GetIDCode() == Config::traceHotkey &&
+		    button->IsDown())
+		{
+			Trace::Toggle();
+		}
+	}
+
+	return RE::BSEventNotifyControl::kContinue;
+}
+#endif
+
+void EventHandler::Receive(const SDSPlayerShieldOnBackSwitchEvent& a_evn)
+{
+	ActorCache::GetPlayer().shieldOnBack.Set(a_evn.isOnBack);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+class EventHandler :
+	public RE::BSTEventSink<RE::TESEquipEvent>,
+	public RE::BSTEventSink<RE::TESObjectLoadedEvent>,
+	public RE::BSTEventSink<RE::MenuOpenCloseEvent>,
+#if defined(ENABLE_PROFILING)
+	public RE::BSTEventSink<RE::InputEvent*>,
+#endif
+	public ::Events::EventSink<SDSPlayerShieldOnBackSwitchEvent>
+{
+public:
+	[[nodiscard]] static EventHandler* GetSingleton()
+	{
+		static EventHandler singleton;
+		return std::addressof(singleton);
+	}
+
+	void RegisterGameEvents();
+	void RegisterSDSEvents(PluginInterfaceSDS* a_interface);
+
+private:
+	EventHandler() = default;
+
+	RE::BSEventNotifyControl ProcessEvent(const RE::TESEquipEvent* a_event, RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource) override;
+	RE::BSEventNotifyControl ProcessEvent(const RE::TESObjectLoadedEvent* a_event, RE::BSTEventSource<RE::TESObjectLoadedEvent>* a_eventSource) override;
+	RE::BSEventNotifyControl ProcessEvent(const RE::MenuOpenCloseEvent* a_event, RE::BSTEventSource<RE::MenuOpenCloseEvent>* a_eventSource) override;
+#if defined(ENABLE_PROFILING)
+	RE::BSEventNotifyControl ProcessEvent(RE::InputEvent* const* a_event, RE::BSTEventSource<RE::InputEvent*>* a_eventSource) override;
+#endif
+
+	void Receive(const SDSPlayerShieldOnBackSwitchEvent& a_evn) override;
+};
@@ -0,0 +1,102 @@
+#include "Hooks.h"
+
+// state the hooks maintain, kept apart from the hook installation so it builds without the game
+namespace Hooks
+{
+	namespace
+	{
+		std::atomic<std::uint32_t> s_frameEpoch{ 1 };
+
+		// activations are spread over shards by generator address, so graphs updating on different threads rarely
+		// contend for the same lock
+		constexpr std::size_t CLIP_SHARD_BITS   = 6;
+		constexpr std::size_t CLIP_SHARD_COUNT  = std::size_t(1) << CLIP_SHARD_BITS;
+		constexpr std::size_t MAX_TRACKED_CLIPS = 16384 / CLIP_SHARD_COUNT;  // per shard
+
+		struct alignas(64) ClipShard
+		{
+			std::shared_mutex                                              lock;
+			std::unordered_map<const RE::hkbClipGenerator*, std::uint32_t> activations;
+		};
+
+		std::atomic<std::uint32_t>              s_clipActivation{ 0 };
+		std::atomic<std::uint32_t>              s_clipCacheUsers{ 0 };
+		std::array<ClipShard, CLIP_SHARD_COUNT> s_clipShards;
+
+		ClipShard& GetClipShard(const RE::hkbClipGenerator* a_clipGenerator) noexcept
+		{
+			// fibonacci hashing, the low bits of heap addresses are mostly alignment
+			const auto hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(a_clipGenerator)) * 0x9E3779B97F4A7C15ull;
+			return s_clipShards[hash >> (64 - CLIP_SHARD_BITS)];
+		}
+	}
+
+	std::uint32_t GetFrameEpoch() noexcept
+	{
+		return s_frameEpoch.load(std::memory_order_relaxed);
+	}
+
+	void AdvanceFrameEpoch() noexcept
+	{
+		if (s_frameEpoch.fetch_add(1, std::memory_order_relaxed) == std::numeric_limits<std::uint32_t>::max())
+		{
+			s_frameEpoch.store(1, std::memory_order_relaxed);
+		}
+	}
+
+	void AddClipCacheUser()
+	{
+		if (s_clipCacheUsers.fetch_add(1, std::memory_order_relaxed) != 0)
+		{
+			return;
+		}
+
+		// activations seen before the last user went away may be stale, the clips start over as not seen
+		for (auto& shard : s_clipShards)
+		{
+			const std::unique_lock lock(shard.lock);
+			shard.activations.clear();
+		}
+	}
+
+	void RemoveClipCacheUser() noexcept
+	{
+		s_clipCacheUsers.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	std::uint32_t GetClipActivation(const RE::hkbClipGenerator* a_clipGenerator)
+	{
+		auto& shard = GetClipShard(a_clipGenerator);
+
+		const std::shared_lock lock(shard.lock);
+
+		const auto it = shard.activations.find(a_clipGenerator);
+		return it != shard.activations.end() ? it->second : 0;
+	}
+
+	void OnClipActivationChanged(const RE::hkbClipGenerator* a_clipGenerator)
+	{
+		if (s_clipCacheUsers.load(std::memory_order_relaxed) == 0)
+		{
+			return;
+		}
+
+		auto activation = s_clipActivation.fetch_add(1, std::memory_order_relaxed) + 1;
+		if (!activation)
+		{
+			activation = s_clipActivation.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
+		auto& shard = GetClipShard(a_clipGenerator);
+
+		const std::unique_lock lock(shard.lock);
+
+		// generators of unloaded graphs are never removed, start over instead of growing without bound
+		if (shard.activations.size() >= MAX_TRACKED_CLIPS)
+		{
+			shard.activations.clear();
+		}
+
+		shard.activations[a_clipGenerator] = activation;
+	}
+}
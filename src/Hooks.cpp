@@ -0,0 +1,96 @@
+#include "Hooks.h"
+
+#include "Capture.h"
+#include "Config.h"
+#include "Profiling.h"
+#include "SettingsSnapshot.h"
+#include "Trace.h"
+
+namespace Hooks
+{
+	namespace
+	{
+		// flushed from the main loop instead of spdlog::flush_every, whose thread would still be running when the
+		// game exits and tears down the plugin's statics
+		void FlushLog()
+		{
+			static auto next = std::chrono::steady_clock::now();
+
+			if (!Config::logFlushInterval)
+			{
+				return;
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			if (now < next)
+			{
+				return;
+			}
+
+			next = now + std::chrono::seconds(Config::logFlushInterval);
+
+			// only queues a flush for the logger's background thread
+			spdlog::default_logger_raw()->flush();
+		}
+
+		struct MainUpdate
+		{
+			static void thunk(RE::Main* a_this, float a_delta)
+			{
+				func(a_this, a_delta);
+
+				SettingsSnapshot::Update();
+				FlushLog();
+
+#if defined(ENABLE_PROFILING)
+				Profiling::Update();
+				Trace::Update();
+				Capture::Update();
+#endif
+
+				AdvanceFrameEpoch();
+			}
+
+			static inline REL::Relocation<decltype(thunk)> func;
+		};
+
+		// bumped before the original runs, so conditions evaluated while activating never see the previous activation
+		struct ClipGeneratorActivate
+		{
+			static void thunk(RE::hkbClipGenerator* a_this, const RE::hkbContext& a_context)
+			{
+				OnClipActivationChanged(a_this);
+				func(a_this, a_context);
+			}
+
+			static inline REL::Relocation<decltype(thunk)> func;
+		};
+
+		// bumped again on deactivation, in case another plugin evaluates conditions in its activate hook before ours runs
+		struct ClipGeneratorDeactivate
+		{
+			static void thunk(RE::hkbClipGenerator* a_this, const RE::hkbContext& a_context)
+			{
+				func(a_this, a_context);
+				OnClipActivationChanged(a_this);
+			}
+
+			static inline REL::Relocation<decltype(thunk)> func;
+		};
+	}
+
+	void Install()
+	{
+		logs::trace("Installing hooks...");
+
+		REL::Relocation<std::uintptr_t> target{ RELOCATION_ID(35565, 36564) };
+
+		auto& trampoline = SKSE::GetTrampoline();
+		MainUpdate::func = trampoline.write_call<5>(target.address() + REL::Relocate(0x748, 0xC26, 0x7EE), MainUpdate::thunk);
+
+		REL::Relocation<std::uintptr_t> clipGeneratorVtbl{ RE::VTABLE_hkbClipGenerator[0] };
+
+		ClipGeneratorActivate::func   = clipGeneratorVtbl.write_vfunc(0x4, ClipGeneratorActivate::thunk);
+		ClipGeneratorDeactivate::func = clipGeneratorVtbl.write_vfunc(0x7, ClipGeneratorDeactivate::thunk);
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace Hooks
+{
+	void Install();
+
+	// incremented once per main loop iteration, never 0
+	[[nodiscard]] std::uint32_t GetFrameEpoch() noexcept;
+
+	// ends the current frame for the per-frame caches, called by the main loop and the host driver
+	void AdvanceFrameEpoch() noexcept;
+
+	// conditions with 'Cache per clip' enabled, activations are only tracked while there is at least one
+	void AddClipCacheUser();
+	void RemoveClipCacheUser() noexcept;
+
+	// changes every time the clip generator is activated or deactivated, 0 if it was not seen since tracking started
+	[[nodiscard]] std::uint32_t GetClipActivation(const RE::hkbClipGenerator* a_clipGenerator);
+
+	// called by the clip generator hooks on activation and deactivation, returns at once while there are no clip cache users
+	void OnClipActivationChanged(const RE::hkbClipGenerator* a_clipGenerator);
+}
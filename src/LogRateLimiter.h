@@ -0,0 +1,43 @@
+#pragma once
+
+// lets at most one message per interval through from the paths that share an instance, for logging from evaluation code
+// messages dropped in between are counted and reported with the next one that passes
+class LogRateLimiter
+{
+public:
+	explicit LogRateLimiter(std::chrono::steady_clock::duration a_interval) noexcept :
+		interval(a_interval.count())
+	{
+	}
+
+	template <class... Args>
+	void Log(spdlog::level::level_enum a_level, spdlog::format_string_t<Args...> a_fmt, Args&&... a_args)
+	{
+		const auto logger = spdlog::default_logger_raw();
+		if (!logger->should_log(a_level))
+		{
+			return;
+		}
+
+		const auto now  = std::chrono::steady_clock::now().time_since_epoch().count();
+		auto       next = nextAllowed.load(std::memory_order_relaxed);
+
+		if (now < next || !nextAllowed.compare_exchange_strong(next, now + interval, std::memory_order_relaxed))
+		{
+			suppressed.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		logger->log(a_level, a_fmt, std::forward<Args>(a_args)...);
+
+		if (const auto count = suppressed.exchange(0, std::memory_order_relaxed))
+		{
+			logger->log(a_level, "({} similar messages suppressed)", count);
+		}
+	}
+
+private:
+	const std::chrono::steady_clock::rep            interval;
+	std::atomic<std::chrono::steady_clock::rep>     nextAllowed{ 0 };
+	std::atomic<std::uint32_t>                      suppressed{ 0 };
+};
@@ -0,0 +1,118 @@
+#include "NodeNamePattern.h"
+
+#include "StringHelpers.h"
+
+NodeNamePattern::NodeNamePattern(std::string_view a_pattern)
+{
+	hasWildcard   = a_pattern.find('*') != std::string_view::npos;
+	anchoredStart = !a_pattern.starts_with('*');
+	anchoredEnd   = !a_pattern.ends_with('*');
+
+	std::size_t start = 0;
+
+	for (std::size_t i = 0; i <= a_pattern.size(); i++)
+	{
+		if (i < a_pattern.size() && a_pattern[i] != '*')
+		{
+			text.push_back(StringHelpers::tolower(a_pattern[i]));
+			continue;
+		}
+
+		if (text.size() > start)
+		{
+			segments.push_back({ static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(text.size() - start) });
+		}
+
+		start = text.size();
+	}
+
+	minLength = text.size();
+}
+
+bool NodeNamePattern::Match(std::string_view a_name) const noexcept
+{
+	if (!hasWildcard)
+	{
+		return a_name.size() == minLength && (segments.empty() || SegmentEquals(segments.front(), a_name.data()));
+	}
+
+	if (a_name.size() < minLength)
+	{
+		return false;
+	}
+
+	auto first = segments.begin();
+	auto last  = segments.end();
+
+	std::size_t begin = 0;
+	std::size_t end   = a_name.size();
+
+	if (anchoredStart && first != last)
+	{
+		if (!SegmentEquals(*first, a_name.data()))
+		{
+			return false;
+		}
+
+		begin = first->size;
+		++first;
+	}
+
+	if (anchoredEnd && first != last)
+	{
+		const auto& suffix = *(last - 1);
+		if (!SegmentEquals(suffix, a_name.data() + end - suffix.size))
+		{
+			return false;
+		}
+
+		end -= suffix.size;
+		--last;
+	}
+
+	for (auto it = first; it != last; ++it)
+	{
+		const auto pos = FindSegment(*it, a_name, begin, end);
+		if (pos == std::string_view::npos)
+		{
+			return false;
+		}
+
+		begin = pos + it->size;
+	}
+
+	return true;
+}
+
+bool NodeNamePattern::SegmentEquals(const Segment& a_segment, const char* a_name) const noexcept
+{
+	const auto pattern = text.data() + a_segment.offset;
+
+	for (std::uint32_t i = 0; i < a_segment.size; i++)
+	{
+		if (pattern[i] != '?' && pattern[i] != StringHelpers::tolower(a_name[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::size_t NodeNamePattern::FindSegment(const Segment& a_segment, std::string_view a_name, std::size_t a_begin, std::size_t a_end) const noexcept
+{
+	if (a_end - a_begin < a_segment.size)
+	{
+		return std::string_view::npos;
+	}
+
+	for (auto i = a_begin; i <= a_end - a_segment.size; i++)
+	{
+		if (SegmentEquals(a_segment, a_name.data() + i))
+		{
+			return i;
+		}
+	}
+
+	return std::string_view::npos;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// case-insensitive wildcard pattern for node names, '*' matches any run of characters and '?' a single one
+// the pattern is split into fixed-length segments on construction, a match places every segment at its
+// leftmost possible position in a single forward pass, which is exact for fixed-length segments and never backtracks
+// immutable once constructed
+class NodeNamePattern
+{
+public:
+	NodeNamePattern() = default;
+	explicit NodeNamePattern(std::string_view a_pattern);
+
+	[[nodiscard]] bool Match(std::string_view a_name) const noexcept;
+
+private:
+	struct Segment
+	{
+		std::uint32_t offset;
+		std::uint32_t size;
+	};
+
+	[[nodiscard]] bool        SegmentEquals(const Segment& a_segment, const char* a_name) const noexcept;
+	[[nodiscard]] std::size_t FindSegment(const Segment& a_segment, std::string_view a_name, std::size_t a_begin, std::size_t a_end) const noexcept;
+
+	std::string          text;  // lowercased segment characters
+	std::vector<Segment> segments;
+	std::size_t          minLength{ 0 };
+	bool                 hasWildcard{ false };
+	bool                 anchoredStart{ true };
+	bool                 anchoredEnd{ true };
+};
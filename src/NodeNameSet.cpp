@@ -0,0 +1,76 @@
+#include "NodeNameSet.h"
+
+#include "StringHelpers.h"
+
+NodeNameSet::NodeNameSet(std::string_view a_list, char a_delimiter)
+{
+	StringHelpers::for_each_item(a_list, a_delimiter, [&](std::string_view a_item) {
+		const auto it = std::ranges::find_if(names, [&](const auto& a_name) {
+			return StringHelpers::iequals(a_name.c_str(), a_item);
+		});
+
+		if (it == names.end())
+		{
+			names.emplace_back(a_item);
+		}
+	});
+
+	if (names.empty())
+	{
+		return;
+	}
+
+	const auto capacity = std::bit_ceil(names.size() * 2);
+
+	mask = capacity - 1;
+	byName.resize(capacity);
+
+	for (std::uint32_t i = 0; i < names.size(); i++)
+	{
+		Insert(byName, StringHelpers::ihash(names[i].c_str()), i + 1);
+	}
+}
+
+bool NodeNameSet::Contains(std::string_view a_name) const noexcept
+{
+	if (names.empty())
+	{
+		return false;
+	}
+
+	return Find(byName, StringHelpers::ihash(a_name), [&](const std::string& a_entry) {
+		return StringHelpers::iequals(a_entry.c_str(), a_name);
+	});
+}
+
+void NodeNameSet::Insert(std::vector<Slot>& a_table, std::uint64_t a_hash, std::uint32_t a_index) noexcept
+{
+	const auto tableMask = a_table.size() - 1;
+
+	for (auto i = static_cast<std::size_t>(a_hash) & tableMask;; i = (i + 1) & tableMask)
+	{
+		if (!a_table[i].index)
+		{
+			a_table[i] = { a_hash, a_index };
+			return;
+		}
+	}
+}
+
+template <class Tf>
+bool NodeNameSet::Find(const std::vector<Slot>& a_table, std::uint64_t a_hash, Tf a_equals) const noexcept
+{
+	for (auto i = static_cast<std::size_t>(a_hash) & mask;; i = (i + 1) & mask)
+	{
+		const auto& slot = a_table[i];
+		if (!slot.index)
+		{
+			return false;
+		}
+
+		if (slot.hash == a_hash && a_equals(names[slot.index - 1]))
+		{
+			return true;
+		}
+	}
+}
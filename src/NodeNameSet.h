@@ -0,0 +1,33 @@
+#pragma once
+
+// case-insensitive set of node names, immutable once constructed and probed without allocating
+// open addressing with linear probing, the table is kept at most half full so a lookup usually touches a single slot
+class NodeNameSet
+{
+public:
+	NodeNameSet() = default;
+
+	// a_list holds names separated by a_delimiter, surrounding whitespace is ignored
+	NodeNameSet(std::string_view a_list, char a_delimiter);
+
+	[[nodiscard]] bool Contains(std::string_view a_name) const noexcept;
+
+	[[nodiscard]] bool        empty() const noexcept { return names.empty(); }
+	[[nodiscard]] std::size_t size() const noexcept { return names.size(); }
+
+private:
+	struct Slot
+	{
+		std::uint64_t hash{ 0 };
+		std::uint32_t index{ 0 };  // into names + 1, 0 marks an empty slot
+	};
+
+	static void Insert(std::vector<Slot>& a_table, std::uint64_t a_hash, std::uint32_t a_index) noexcept;
+
+	template <class Tf>
+	[[nodiscard]] bool Find(const std::vector<Slot>& a_table, std::uint64_t a_hash, Tf a_equals) const noexcept;
+
+	std::vector<std::string> names;
+	std::vector<Slot>        byName;  // keyed by StringHelpers::ihash of the text
+	std::size_t              mask{ 0 };
+};
@@ -0,0 +1,170 @@
+#include "Profiling.h"
+
+#include "Config.h"
+
+namespace Profiling
+{
+	namespace
+	{
+		constexpr auto TYPE_COUNT = static_cast<std::size_t>(Conditions::ConditionID::kTotal);
+
+		// written only by the owning thread, read by Report
+		struct ThreadCounters
+		{
+			struct Type
+			{
+				std::atomic<std::uint64_t>                                calls{ 0 };
+				std::atomic<std::uint64_t>                                trueResults{ 0 };
+				std::atomic<std::uint64_t>                                cycles{ 0 };
+				std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS> histogram{};
+			};
+
+			std::array<Type, TYPE_COUNT> types;
+		};
+
+		struct Totals
+		{
+			std::uint64_t                                calls{ 0 };
+			std::uint64_t                                trueResults{ 0 };
+			std::uint64_t                                cycles{ 0 };
+			std::array<std::uint64_t, HISTOGRAM_BUCKETS> histogram{};
+		};
+
+		std::mutex                                   s_lock;
+		std::vector<std::unique_ptr<ThreadCounters>> s_threads;  // kept after their thread exits
+		std::array<Totals, TYPE_COUNT>               s_previous;
+
+		std::chrono::steady_clock::time_point s_lastReport{ std::chrono::steady_clock::now() };
+
+		thread_local ThreadCounters* t_counters = nullptr;
+
+		ThreadCounters& GetThreadCounters()
+		{
+			if (!t_counters)
+			{
+				const std::lock_guard lock(s_lock);
+				t_counters = s_threads.emplace_back(std::make_unique<ThreadCounters>()).get();
+			}
+
+			return *t_counters;
+		}
+
+		void Increment(std::atomic<std::uint64_t>& a_counter, std::uint64_t a_value = 1) noexcept
+		{
+			a_counter.store(a_counter.load(std::memory_order_relaxed) + a_value, std::memory_order_relaxed);
+		}
+
+		std::size_t GetBucket(std::uint64_t a_cycles) noexcept
+		{
+			const auto bucket = a_cycles ? static_cast<std::size_t>(std::bit_width(a_cycles) - 1) : 0;
+			return std::min(bucket, HISTOGRAM_BUCKETS - 1);
+		}
+
+		// upper bound of the bucket that contains the given fraction of samples
+		std::uint64_t GetPercentile(const Totals& a_totals, double a_fraction)
+		{
+			const auto target = static_cast<std::uint64_t>(std::ceil(static_cast<double>(a_totals.calls) * a_fraction));
+
+			std::uint64_t count = 0;
+			for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+			{
+				count += a_totals.histogram[i];
+				if (count >= target)
+				{
+					return std::uint64_t(1) << (i + 1);
+				}
+			}
+
+			return std::uint64_t(1) << HISTOGRAM_BUCKETS;
+		}
+	}
+
+	void Record(Conditions::ConditionID a_id, bool a_result, std::uint64_t a_cycles) noexcept
+	{
+		auto& type = GetThreadCounters().types[static_cast<std::size_t>(a_id)];
+
+		Increment(type.calls);
+		if (a_result)
+		{
+			Increment(type.trueResults);
+		}
+		Increment(type.cycles, a_cycles);
+		Increment(type.histogram[GetBucket(a_cycles)]);
+	}
+
+	void Report(bool a_toConsole)
+	{
+		std::array<Totals, TYPE_COUNT> current{};
+
+		const std::lock_guard lock(s_lock);
+
+		for (const auto& thread : s_threads)
+		{
+			for (std::size_t i = 0; i < TYPE_COUNT; i++)
+			{
+				const auto& type = thread->types[i];
+				auto&       e    = current[i];
+
+				e.calls += type.calls.load(std::memory_order_relaxed);
+				e.trueResults += type.trueResults.load(std::memory_order_relaxed);
+				e.cycles += type.cycles.load(std::memory_order_relaxed);
+
+				for (std::size_t j = 0; j < HISTOGRAM_BUCKETS; j++)
+				{
+					e.histogram[j] += type.histogram[j].load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		const auto console = a_toConsole ? RE::ConsoleLog::GetSingleton() : nullptr;
+
+		logs::info("Condition evaluation stats ({} threads):"sv, s_threads.size());
+
+		for (std::size_t i = 0; i < TYPE_COUNT; i++)
+		{
+			Totals delta;
+
+			delta.calls       = current[i].calls - s_previous[i].calls;
+			delta.trueResults = current[i].trueResults - s_previous[i].trueResults;
+			delta.cycles      = current[i].cycles - s_previous[i].cycles;
+
+			for (std::size_t j = 0; j < HISTOGRAM_BUCKETS; j++)
+			{
+				delta.histogram[j] = current[i].histogram[j] - s_previous[i].histogram[j];
+			}
+
+			if (!delta.calls)
+			{
+				continue;
+			}
+
+			const auto text = std::format(
+				"{}: {} calls, {:.1f}% true, avg {} cycles, p50 < {} cycles, p99 < {} cycles",
+				Conditions::GetConditionName(static_cast<Conditions::ConditionID>(i)),
+				delta.calls,
+				static_cast<double>(delta.trueResults) * 100.0 / static_cast<double>(delta.calls),
+				delta.cycles / delta.calls,
+				GetPercentile(delta, 0.5),
+				GetPercentile(delta, 0.99));
+
+			logs::info("  {}"sv, text);
+
+			if (console)
+			{
+				console->Print("%s", text.c_str());
+			}
+		}
+
+		s_previous   = current;
+		s_lastReport = std::chrono::steady_clock::now();
+	}
+
+	void Update()
+	{
+		const auto interval = Config::profilingReportInterval;
+		if (interval && std::chrono::steady_clock::now() - s_lastReport >= std::chrono::seconds(interval))
+		{
+			Report();
+		}
+	}
+}
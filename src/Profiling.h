@@ -0,0 +1,36 @@
+#pragma once
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#else
+#	include <x86intrin.h>
+#endif
+
+#include "ConditionID.h"
+
+// per condition type evaluation counters and latency histograms, compiled in with the 'profiling' option
+namespace Profiling
+{
+#if defined(ENABLE_PROFILING)
+	constexpr bool ENABLED = true;
+#else
+	constexpr bool ENABLED = false;
+#endif
+
+	// bucket i counts evaluations that took [2^i, 2^(i+1)) cycles
+	constexpr std::size_t HISTOGRAM_BUCKETS = 32;
+
+	[[nodiscard]] inline std::uint64_t ReadCycleCounter() noexcept
+	{
+		return __rdtsc();
+	}
+
+	// lock-free, only touches the calling thread's counters
+	void Record(Conditions::ConditionID a_id, bool a_result, std::uint64_t a_cycles) noexcept;
+
+	// merges all threads' counters and writes everything recorded since the previous report to the log
+	void Report(bool a_toConsole = false);
+
+	// called every frame, reports at the configured interval
+	void Update();
+}
@@ -0,0 +1,70 @@
+#include "SettingsSnapshot.h"
+
+#include "Interface.h"
+
+namespace SettingsSnapshot
+{
+	namespace
+	{
+		constexpr auto        REFRESH_INTERVAL    = 1s;
+		constexpr std::size_t PLUGIN_OPTION_COUNT = stl::to_underlying(PluginOptionKey::kFrostfallAnimAtk) + 1;
+
+		std::array<std::atomic<std::int32_t>, PLUGIN_OPTION_COUNT> s_pluginOptions{};
+		std::atomic<bool>                                          s_pluginOptionsValid{ false };
+		std::atomic<bool>                                          s_weaponNodeSharingDisabled{ false };
+		std::atomic<bool>                                          s_weaponNodeSharingValid{ false };
+
+		std::chrono::steady_clock::time_point s_lastRefresh;
+	}
+
+	void Refresh()
+	{
+		if (g_interfaceIED)
+		{
+			for (std::size_t i = 0; i < PLUGIN_OPTION_COUNT; i++)
+			{
+				const auto value = g_interfaceIED->GetPluginOption(static_cast<PluginOptionKey>(i));
+				s_pluginOptions[i].store(value, std::memory_order_relaxed);
+			}
+
+			s_pluginOptionsValid.store(true, std::memory_order_release);
+		}
+
+		if (g_interfaceSDS)
+		{
+			s_weaponNodeSharingDisabled.store(g_interfaceSDS->IsWeaponNodeSharingDisabled(), std::memory_order_relaxed);
+			s_weaponNodeSharingValid.store(true, std::memory_order_release);
+		}
+
+		s_lastRefresh = std::chrono::steady_clock::now();
+	}
+
+	void Update()
+	{
+		if (std::chrono::steady_clock::now() - s_lastRefresh >= REFRESH_INTERVAL)
+		{
+			Refresh();
+		}
+	}
+
+	std::int32_t GetPluginOption(PluginOptionKey a_key)
+	{
+		const auto index = stl::to_underlying(a_key);
+		if (index < PLUGIN_OPTION_COUNT && s_pluginOptionsValid.load(std::memory_order_acquire))
+		{
+			return s_pluginOptions[index].load(std::memory_order_relaxed);
+		}
+
+		return g_interfaceIED->GetPluginOption(a_key);
+	}
+
+	bool IsWeaponNodeSharingDisabled()
+	{
+		if (s_weaponNodeSharingValid.load(std::memory_order_acquire))
+		{
+			return s_weaponNodeSharingDisabled.load(std::memory_order_relaxed);
+		}
+
+		return g_interfaceSDS->IsWeaponNodeSharingDisabled();
+	}
+}
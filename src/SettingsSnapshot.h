@@ -0,0 +1,13 @@
+#pragma once
+
+// global IED/SDS settings, read from the plugins at load, on menu close and periodically
+namespace SettingsSnapshot
+{
+	using PluginOptionKey = PluginInterfaceIED::PluginOptionKey;
+
+	void Refresh();
+	void Update();  // called every frame, refreshes at a low fixed rate
+
+	[[nodiscard]] std::int32_t GetPluginOption(PluginOptionKey a_key);
+	[[nodiscard]] bool         IsWeaponNodeSharingDisabled();
+}
@@ -0,0 +1,84 @@
+#include "SharedResults.h"
+
+#include "Hooks.h"
+
+namespace
+{
+	struct Registry
+	{
+		std::mutex                                                 lock;
+		std::map<SharedResults::Key, std::weak_ptr<SharedResults>> results;
+	};
+
+	// never destroyed, conditions held in static storage may release their results after it would have been
+	Registry& GetRegistry()
+	{
+		static const auto registry = new Registry;
+		return *registry;
+	}
+}
+
+std::shared_ptr<SharedResults> SharedResults::Acquire(Key a_key)
+{
+	auto& registry = GetRegistry();
+
+	const std::lock_guard lock(registry.lock);
+
+	auto& entry = registry.results[a_key];
+	if (auto result = entry.lock())
+	{
+		return result;
+	}
+
+	std::shared_ptr<SharedResults> result(new SharedResults, [key = std::move(a_key)](SharedResults* a_results) {
+		Release(key);
+		delete a_results;
+	});
+
+	entry = result;
+
+	return result;
+}
+
+void SharedResults::Release(const Key& a_key)
+{
+	auto& registry = GetRegistry();
+
+	const std::lock_guard lock(registry.lock);
+
+	// an instance may have acquired the key again before the last one was released
+	if (const auto it = registry.results.find(a_key); it != registry.results.end() && it->second.expired())
+	{
+		registry.results.erase(it);
+	}
+}
+
+std::optional<bool> SharedResults::Get(RE::FormID a_formID) const noexcept
+{
+	const auto value = slots[GetSlot(a_formID)].load(std::memory_order_relaxed);
+
+	if ((value & ~std::uint64_t(1)) != Pack(a_formID, Hooks::GetFrameEpoch(), false))
+	{
+		return std::nullopt;
+	}
+
+	return (value & 1) != 0;
+}
+
+void SharedResults::Set(RE::FormID a_formID, bool a_result) noexcept
+{
+	slots[GetSlot(a_formID)].store(Pack(a_formID, Hooks::GetFrameEpoch(), a_result), std::memory_order_relaxed);
+}
+
+std::uint64_t SharedResults::Pack(RE::FormID a_formID, std::uint32_t a_epoch, bool a_result) noexcept
+{
+	return (static_cast<std::uint64_t>(a_formID) << 32) |
+	       (static_cast<std::uint64_t>(a_epoch & 0x7FFFFFFF) << 1) |
+	       static_cast<std::uint64_t>(a_result);
+}
+
+std::size_t SharedResults::GetSlot(RE::FormID a_formID) noexcept
+{
+	// the low byte of a form ID is spread fairly evenly, the high byte is the load order index
+	return static_cast<std::size_t>((a_formID ^ (a_formID >> 24)) % SLOT_COUNT);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// result slots shared by condition instances with the same type and static arguments, valid for a single frame
+// every ref hashes to one slot, a ref that collides with another simply misses
+class SharedResults
+{
+public:
+	static constexpr std::size_t SLOT_COUNT = 64;
+
+	// the condition type and every argument the result depends on
+	using Key = std::vector<std::uint64_t>;
+
+	// instances acquiring an equal key share one object, it is freed when the last of them releases it
+	[[nodiscard]] static std::shared_ptr<SharedResults> Acquire(Key a_key);
+
+	[[nodiscard]] std::optional<bool> Get(RE::FormID a_formID) const noexcept;
+	void                              Set(RE::FormID a_formID, bool a_result) noexcept;
+
+private:
+	static void Release(const Key& a_key);
+
+	// form ID << 32 | (frame epoch & 0x7FFFFFFF) << 1 | result
+	[[nodiscard]] static std::uint64_t Pack(RE::FormID a_formID, std::uint32_t a_epoch, bool a_result) noexcept;
+	[[nodiscard]] static std::size_t   GetSlot(RE::FormID a_formID) noexcept;
+
+	std::array<std::atomic<std::uint64_t>, SLOT_COUNT> slots{};
+};
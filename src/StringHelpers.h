@@ -0,0 +1,65 @@
+#pragma once
+
+namespace StringHelpers
+{
+	[[nodiscard]] constexpr char tolower(char a_char) noexcept
+	{
+		return a_char >= 'A' && a_char <= 'Z' ? static_cast<char>(a_char - 'A' + 'a') : a_char;
+	}
+
+	// ASCII case-insensitive comparison, matches how the game compares node names
+	[[nodiscard]] constexpr bool iequals(std::string_view a_lhs, std::string_view a_rhs) noexcept
+	{
+		if (a_lhs.size() != a_rhs.size())
+		{
+			return false;
+		}
+
+		for (std::size_t i = 0; i < a_lhs.size(); i++)
+		{
+			if (tolower(a_lhs[i]) != tolower(a_rhs[i]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// ASCII case-insensitive FNV-1a, names that compare equal with iequals hash equally
+	[[nodiscard]] constexpr std::uint64_t ihash(std::string_view a_text) noexcept
+	{
+		std::uint64_t result = 0xCBF29CE484222325;
+
+		for (const auto c : a_text)
+		{
+			result ^= static_cast<std::uint8_t>(tolower(c));
+			result *= 0x100000001B3;
+		}
+
+		return result;
+	}
+
+	// splits on a_delimiter and strips surrounding spaces and tabs, empty items are skipped
+	template <class Tf>
+	constexpr void for_each_item(std::string_view a_list, char a_delimiter, Tf a_func)
+	{
+		while (!a_list.empty())
+		{
+			const auto pos  = a_list.find(a_delimiter);
+			auto       item = a_list.substr(0, pos);
+
+			a_list = pos == std::string_view::npos ? std::string_view{} : a_list.substr(pos + 1);
+
+			const auto first = item.find_first_not_of(" \t");
+			if (first == std::string_view::npos)
+			{
+				continue;
+			}
+
+			item = item.substr(first, item.find_last_not_of(" \t") - first + 1);
+
+			a_func(item);
+		}
+	}
+}
@@ -0,0 +1,267 @@
+#include "Trace.h"
+
+#include <fstream>
+#include <thread>
+
+#include "Config.h"
+#include "Profiling.h"
+
+namespace Trace
+{
+	namespace
+	{
+		struct Span
+		{
+			std::uint64_t           start;
+			std::uint64_t           end;
+			RE::FormID              formID;
+			Conditions::ConditionID id;
+			bool                    result;
+		};
+
+		// written only by the owning thread while a capture is active, session and count are also read by the exporter
+		struct ThreadBuffer
+		{
+			explicit ThreadBuffer(std::uint32_t a_index, std::size_t a_capacity) :
+				index(a_index),
+				spans(a_capacity)
+			{
+			}
+
+			const std::uint32_t        index;
+			std::atomic<std::uint32_t> session{ 0 };
+			std::atomic<std::uint64_t> count{ 0 };
+			std::vector<Span>          spans;
+		};
+
+		struct Capture
+		{
+			std::uint64_t                         startCycles{ 0 };
+			std::uint64_t                         endCycles{ 0 };
+			std::chrono::steady_clock::time_point startTime;
+			std::chrono::steady_clock::time_point endTime;
+		};
+
+		std::mutex                                 s_lock;
+		std::vector<std::unique_ptr<ThreadBuffer>> s_threads;
+
+		std::atomic<bool>          s_active{ false };
+		std::atomic<std::uint32_t> s_session{ 0 };
+
+		// main thread only
+		Capture       s_capture;
+		std::uint32_t s_framesLeft{ 0 };
+		bool          s_exportPending{ false };
+
+		thread_local ThreadBuffer* t_buffer = nullptr;
+
+		ThreadBuffer& GetThreadBuffer()
+		{
+			if (!t_buffer)
+			{
+				const std::lock_guard lock(s_lock);
+
+				const auto capacity = std::max<std::size_t>(Config::traceBufferSize, 1);
+				t_buffer            = s_threads.emplace_back(std::make_unique<ThreadBuffer>(static_cast<std::uint32_t>(s_threads.size()), capacity)).get();
+			}
+
+			return *t_buffer;
+		}
+
+		struct ThreadSpans
+		{
+			std::uint32_t     index;
+			std::vector<Span> spans;
+		};
+
+		void Export(Capture a_capture, std::vector<ThreadSpans> a_threads)
+		{
+			auto path = logs::log_directory();
+			if (!path)
+			{
+				return;
+			}
+
+			const auto plugin = SKSE::PluginDeclaration::GetSingleton();
+			*path /= std::format("{}_trace_{}.json", plugin->GetName(), a_capture.startTime.time_since_epoch().count());
+
+			std::ofstream file(*path, std::ios::out | std::ios::trunc);
+			if (!file)
+			{
+				logs::error("Failed to open {}"sv, path->string());
+				return;
+			}
+
+			const auto elapsedCycles = static_cast<double>(a_capture.endCycles - a_capture.startCycles);
+			const auto elapsedUs     = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(a_capture.endTime - a_capture.startTime).count());
+			const auto usPerCycle    = elapsedCycles > 0.0 ? elapsedUs / elapsedCycles : 0.0;
+
+			const auto toUs = [&](std::uint64_t a_cycles) {
+				return static_cast<double>(a_cycles - a_capture.startCycles) * usPerCycle;
+			};
+
+			std::size_t total = 0;
+
+			file << R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+			bool first = true;
+			for (const auto& thread : a_threads)
+			{
+				file << (first ? "" : ",")
+					 << std::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"Thread {}"}}}})", thread.index, thread.index);
+				first = false;
+
+				for (const auto& span : thread.spans)
+				{
+					file << std::format(
+						R"(,{{"name":"{}","cat":"condition","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f},"args":{{"refr":"0x{:08X}","result":{}}}}})",
+						Conditions::GetConditionName(span.id),
+						thread.index,
+						toUs(span.start),
+						static_cast<double>(span.end - span.start) * usPerCycle,
+						span.formID,
+						span.result);
+				}
+
+				total += thread.spans.size();
+			}
+
+			file << "]}";
+
+			logs::info("Wrote {} condition spans to {}"sv, total, path->string());
+		}
+
+		void CollectAndExport()
+		{
+			std::vector<ThreadSpans> threads;
+
+			{
+				const std::lock_guard lock(s_lock);
+
+				const auto session = s_session.load(std::memory_order_relaxed);
+
+				for (const auto& buffer : s_threads)
+				{
+					if (buffer->session.load(std::memory_order_acquire) != session)
+					{
+						continue;
+					}
+
+					const auto count    = buffer->count.load(std::memory_order_acquire);
+					const auto capacity = buffer->spans.size();
+					const auto first    = count > capacity ? count - capacity : 0;
+
+					auto& e = threads.emplace_back(ThreadSpans{ buffer->index, {} });
+					e.spans.reserve(static_cast<std::size_t>(count - first));
+
+					for (auto i = first; i < count; i++)
+					{
+						e.spans.emplace_back(buffer->spans[static_cast<std::size_t>(i % capacity)]);
+					}
+
+					std::ranges::sort(e.spans, {}, &Span::start);
+				}
+			}
+
+			std::thread(Export, s_capture, std::move(threads)).detach();
+		}
+	}
+
+	void Start()
+	{
+		if (s_active.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		// a capture stopped during this frame hasn't been collected yet, write it out before its buffers are reused
+		if (s_exportPending)
+		{
+			s_exportPending = false;
+			CollectAndExport();
+		}
+
+		s_capture.startTime   = std::chrono::steady_clock::now();
+		s_capture.startCycles = Profiling::ReadCycleCounter();
+		s_framesLeft          = Config::traceFrames;
+
+		s_session.fetch_add(1, std::memory_order_relaxed);
+		s_active.store(true, std::memory_order_release);
+
+		logs::info("Condition trace started"sv);
+	}
+
+	void Stop()
+	{
+		if (!s_active.exchange(false, std::memory_order_acq_rel))
+		{
+			return;
+		}
+
+		s_capture.endTime   = std::chrono::steady_clock::now();
+		s_capture.endCycles = Profiling::ReadCycleCounter();
+
+		// evaluations in flight finish during this frame, the buffers are collected on the next one
+		s_exportPending = true;
+
+		logs::info("Condition trace stopped"sv);
+	}
+
+	void Toggle()
+	{
+		if (IsActive())
+		{
+			Stop();
+		}
+		else
+		{
+			Start();
+		}
+	}
+
+	bool IsActive() noexcept
+	{
+		return s_active.load(std::memory_order_relaxed);
+	}
+
+	void Record(
+		Conditions::ConditionID a_id,
+		RE::FormID              a_formID,
+		bool                    a_result,
+		std::uint64_t           a_startCycles,
+		std::uint64_t           a_endCycles) noexcept
+	{
+		if (!s_active.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		auto& buffer = GetThreadBuffer();
+
+		// the count is reset before the new session is published, so the exporter never pairs it with the old spans
+		const auto session = s_session.load(std::memory_order_relaxed);
+		if (buffer.session.load(std::memory_order_relaxed) != session)
+		{
+			buffer.count.store(0, std::memory_order_relaxed);
+			buffer.session.store(session, std::memory_order_release);
+		}
+
+		const auto count = buffer.count.load(std::memory_order_relaxed);
+
+		buffer.spans[static_cast<std::size_t>(count % buffer.spans.size())] = { a_startCycles, a_endCycles, a_formID, a_id, a_result };
+		buffer.count.store(count + 1, std::memory_order_release);
+	}
+
+	void Update()
+	{
+		if (s_exportPending)
+		{
+			s_exportPending = false;
+			CollectAndExport();
+		}
+		else if (s_framesLeft && IsActive() && --s_framesLeft == 0)
+		{
+			Stop();
+		}
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ConditionID.h"
+
+// time-bounded capture of individual condition evaluations, exported as Chrome trace-event JSON
+// spans are only recorded in builds with the 'profiling' option
+namespace Trace
+{
+	void Start();
+	void Stop();
+	void Toggle();
+
+	[[nodiscard]] bool IsActive() noexcept;
+
+	// lock-free, writes into the calling thread's ring buffer while a capture is active
+	void Record(
+		Conditions::ConditionID a_id,
+		RE::FormID              a_formID,
+		bool                    a_result,
+		std::uint64_t           a_startCycles,
+		std::uint64_t           a_endCycles) noexcept;
+
+	// called every frame, ends frame-limited captures and writes finished ones out
+	void Update();
+}
@@ -1,8 +1,15 @@
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/msvc_sink.h>
 
+#include "ActorCache.h"
 #include "Conditions.h"
+#include "Config.h"
+#include "ConsoleCommand.h"
+#include "EventHandler.h"
+#include "Hooks.h"
 #include "Interface.h"
+#include "SettingsSnapshot.h"
 
 void InitLogging()
 {
@@ -24,9 +31,16 @@ void InitLogging()
 	const auto level = spdlog::level::info;
 #endif
 
-	auto logger = std::make_shared<spdlog::logger>("global", sinks.begin(), sinks.end());
+	// messages are formatted on the calling thread and written by a single background thread
+	spdlog::init_thread_pool(std::max<std::size_t>(Config::logQueueSize, 1), 1);
+
+	const auto overflowPolicy = Config::logBlockOnOverflow ?
+	                                spdlog::async_overflow_policy::block :
+	                                spdlog::async_overflow_policy::overrun_oldest;
+
+	auto logger = std::make_shared<spdlog::async_logger>("global", sinks.begin(), sinks.end(), spdlog::thread_pool(), overflowPolicy);
 	logger->set_level(level);
-	logger->flush_on(level);
+	logger->flush_on(spdlog::level::warn);
 
 	spdlog::set_default_logger(std::move(logger));
 	spdlog::set_pattern("[%^%L%$] %v");
@@ -58,41 +72,67 @@ void InitMessaging()
 	logs::trace("Initializing messaging listener...");
 	const auto intfc = SKSE::GetMessagingInterface();
 	if (!intfc->RegisterListener([](SKSE::MessagingInterface::Message* a_msg) {
-			if (a_msg->type == SKSE::MessagingInterface::kPostPostLoad)
+			switch (a_msg->type)
 			{
-				OAR_API::Conditions::GetAPI(OAR_API::Conditions::InterfaceVersion::V2);
-				if (g_oarConditionsInterface)
+			case SKSE::MessagingInterface::kPostPostLoad:
 				{
-					RegisterCondition<Conditions::IEDHasEquipmentSlot>();
-					RegisterCondition<Conditions::IEDIsBoundWeaponEquipped>();
-
-					if (auto result = PluginInterfaceBase::query_interface<PluginInterfaceIED>())
+					OAR_API::Conditions::GetAPI(OAR_API::Conditions::InterfaceVersion::V2);
+					if (g_oarConditionsInterface)
 					{
-						g_interfaceIED = result.intfc;
-						RegisterCondition<Conditions::IEDNodePlacementCondition>();
-						RegisterCondition<Conditions::IEDNodeEquippedPlacementCondition>();
-						RegisterCondition<Conditions::IEDNodeParentNameCondition>();
-						RegisterCondition<Conditions::IEDPluginOptionCondition>();
+						RegisterCondition<Conditions::IEDHasEquipmentSlot>();
+						RegisterCondition<Conditions::IEDIsBoundWeaponEquipped>();
+						RegisterCondition<Conditions::IEDEquippedWeaponTraitsCondition>();
+
+						if (auto result = PluginInterfaceBase::query_interface<PluginInterfaceIED>())
+						{
+							g_interfaceIED = result.intfc;
+
+							RegisterCondition<Conditions::IEDNodePlacementCondition>();
+							RegisterCondition<Conditions::IEDNodesPlacementCondition>();
+							RegisterCondition<Conditions::IEDNodeEquippedPlacementCondition>();
+							RegisterCondition<Conditions::IEDNodeParentNameCondition>();
+							RegisterCondition<Conditions::IEDNodeParentNameInListCondition>();
+							RegisterCondition<Conditions::IEDPluginOptionCondition>();
+						}
+						else
+						{
+							logs::error("Failed to query IED interface: {}"sv, PluginInterfaceIED::get_error_string(result.error));
+						}
+
+						if (auto result = PluginInterfaceBase::query_interface<PluginInterfaceSDS>())
+						{
+							g_interfaceSDS = result.intfc;
+							EventHandler::GetSingleton()->RegisterSDSEvents(g_interfaceSDS);
+
+							RegisterCondition<Conditions::SDSShieldOnBackEnabledCondition>();
+							RegisterCondition<Conditions::SDSWeaponNodeSharingDisabledCondition>();
+						}
+						else
+						{
+							logs::error("Failed to query SDS interface: {}"sv, PluginInterfaceSDS::get_error_string(result.error));
+						}
 					}
 					else
 					{
-						logs::error("Failed to query IED interface: {}"sv, PluginInterfaceIED::get_error_string(result.error));
-					}
-
-					if (auto result = PluginInterfaceBase::query_interface<PluginInterfaceSDS>())
-					{
-						g_interfaceSDS = result.intfc;
-						RegisterCondition<Conditions::SDSShieldOnBackEnabledCondition>();
+						logs::error("Failed to request Open Animation Replacer API"sv);
 					}
-					else
-					{
-						logs::error("Failed to query SDS interface: {}"sv, PluginInterfaceSDS::get_error_string(result.error));
-					}
-				}
-				else
-				{
-					logs::error("Failed to request Open Animation Replacer API"sv);
 				}
+				break;
+			case SKSE::MessagingInterface::kDataLoaded:
+				EventHandler::GetSingleton()->RegisterGameEvents();
+#if defined(ENABLE_PROFILING)
+				ConsoleCommand::Install();
+#endif
+				SettingsSnapshot::Refresh();
+				break;
+			case SKSE::MessagingInterface::kPreLoadGame:
+				ActorCache::InvalidateAll();
+				break;
+			case SKSE::MessagingInterface::kPostLoadGame:
+			case SKSE::MessagingInterface::kNewGame:
+				ActorCache::InvalidateAll();
+				SettingsSnapshot::Refresh();
+				break;
 			}
 		}))
 	{
@@ -102,12 +142,19 @@ void InitMessaging()
 
 SKSEPluginLoad(const SKSE::LoadInterface* a_skse)
 {
+	Config::Load();
+
 	InitLogging();
 
 	const auto plugin = SKSE::PluginDeclaration::GetSingleton();
 	logs::info("{} v{} is loading...", plugin->GetName(), plugin->GetVersion());
 
+	Config::LogLoadResult();
+
 	SKSE::Init(a_skse);
+	SKSE::AllocTrampoline(14);
+
+	Hooks::Install();
 	InitMessaging();
 
 	logs::info("{} loaded.", plugin->GetName());
@@ -3,14 +3,14 @@ set_xmakever("2.7.8")
 
 -- set project
 set_project("OpenAnimationReplacer-IEDConditionExtensions")
-set_version("1.0.1")
+set_version("1.1.0")
 set_license("gplv3")
 set_languages("c++20")
 set_optimize("faster")
 set_warnings("allextra", "error")
 
 -- set allowed
-set_allowedarchs("windows|x64")
+set_allowedarchs("windows|x64", "linux|x86_64")
 set_allowedmodes("debug", "releasedbg")
 
 -- set defaults
@@ -24,13 +24,27 @@ add_rules("plugin.vsxmake.autoupdate")
 -- set policies
 set_policy("package.requires_lock", true)
 
+-- add options
+option("profiling")
+    set_default(false)
+    set_description("Instrument condition evaluation with counters and latency histograms")
+    add_defines("ENABLE_PROFILING")
+option_end()
+
 -- require packages
-add_requires("commonlibsse-ng", { configs = { skyrim_vr = true } })
+if is_plat("windows") then
+    add_requires("commonlibsse-ng", { configs = { skyrim_vr = true } })
+else
+    add_requires("spdlog", "rapidjson")
+end
+add_requires("simpleini")
 
 -- targets
+if is_plat("windows") then
 target("OpenAnimationReplacer-IEDConditionExtensions")
     -- add packages to target
-    add_packages("fmt", "spdlog", "commonlibsse-ng")
+    add_packages("fmt", "spdlog", "commonlibsse-ng", "simpleini")
+    add_options("profiling")
 
     -- add commonlibsse-ng plugin
     add_rules("@commonlibsse-ng/plugin", {
@@ -63,3 +77,29 @@ target("OpenAnimationReplacer-IEDConditionExtensions")
             copy(os.getenv("SKYRIM_PATH"), "Data")
         end
     end)
+end
+
+-- host build of the conditions against mock IED, SDS and OAR (xmake f -p linux), see README
+if is_plat("linux") then
+target("OARIEDHost")
+    set_kind("binary")
+    add_packages("spdlog", "rapidjson", "simpleini")
+
+    -- the condition sources that don't touch the game, everything else comes from host/
+    add_files(
+        "src/API/ModuleLoader.cpp",
+        "src/API/OpenAnimationReplacer-ConditionTypes.cpp",
+        "src/API/OpenAnimationReplacerAPI-Conditions.cpp",
+        "src/ActorCache.cpp",
+        "src/Conditions.cpp",
+        "src/HookState.cpp",
+        "src/Interface.cpp",
+        "src/NodeNamePattern.cpp",
+        "src/NodeNameSet.cpp",
+        "src/SettingsSnapshot.cpp",
+        "src/SharedResults.cpp",
+        "host/*.cpp")
+    add_headerfiles("host/**.h")
+    add_includedirs("host/include", "host", "src")
+    set_pcxxheader("src/pch.h")
+end